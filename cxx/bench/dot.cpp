@@ -1,6 +1,7 @@
 #define CATCH_CONFIG_ENABLE_BENCHMARKING
 
 #include "rl/algo/common.hpp"
+#include "rl/algo/reduce.hpp"
 #include "rl/sys/threads.hpp"
 #include <catch2/benchmark/catch_benchmark_all.hpp>
 #include <catch2/catch_approx.hpp>
@@ -36,13 +37,21 @@ TEST_CASE("Core-Dot", "[Dot]")
   vec1.setRandom();
   vec2.setRandom();
 
-  rl::Cx d = 0.f, pwd = 0.f, pd = 0.f;
+  rl::Cx               d = 0.f, pwd = 0.f, pd = 0.f;
+  std::complex<double> cd = 0.;
 
   BENCHMARK("Dot") { d = vec1.dot(vec2); };
   BENCHMARK("Pairwise Dot") { pwd = rl::PairwiseDot(vec1, vec2, 0, vec1.size()); };
+  BENCHMARK(fmt::format("Compensated Dot {}", rl::CompensatedISA())) { cd = rl::CompensatedDot(vec1.data(), vec2.data(), sz); };
   BENCHMARK("Parallel Dot") { pd = rl::ParallelDot(vec1, vec2); };
 
-  INFO("Dot     " << d << "\nPWD     " << pwd << "\nPar Dot " << pd);
+  std::complex<long double> acc = 0.; // Reference without a double-precision copy of the vectors
+  for (rl::Index ii = 0; ii < sz; ii++) {
+    acc += std::conj(std::complex<long double>(vec1[ii])) * std::complex<long double>(vec2[ii]);
+  }
+  std::complex<double> const ref(acc);
+  INFO("Double  " << ref << "\nDot     " << d << "\nPWD     " << pwd << "\nComp    " << cd << "\nPar Dot " << pd);
   CHECK(std::abs(d - pwd) == Approx(0.f).margin(1.e-6f * sz));
   CHECK(std::abs(pd - pwd) == Approx(0.f).margin(1.e-6f * sz));
+  CHECK(std::abs(cd - ref) <= std::abs(std::complex<double>(pwd) - ref));
 }
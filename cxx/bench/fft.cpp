@@ -0,0 +1,47 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include "rl/fft.hpp"
+#include "rl/log.hpp"
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace rl;
+
+TEST_CASE("FFT-Small", "[FFT]")
+{
+  /* Small transforms are dominated by per-call overhead */
+  Index const M = 16;
+  Cx5         x(M, M, M, 1, 1);
+  x.setRandom();
+  Cx5Map xm(x.data(), x.dimensions());
+  FFT::SetPlanCache(false);
+  BENCHMARK("FFT Forward 16^3 Uncached") { FFT::Forward(xm, Sz3{0, 1, 2}); };
+  BENCHMARK("FFT Adjoint 16^3 Uncached") { FFT::Adjoint(xm, Sz3{0, 1, 2}); };
+  FFT::SetPlanCache(true);
+  BENCHMARK("FFT Forward 16^3") { FFT::Forward(xm, Sz3{0, 1, 2}); };
+  BENCHMARK("FFT Adjoint 16^3") { FFT::Adjoint(xm, Sz3{0, 1, 2}); };
+}
+
+TEST_CASE("FFT-Large", "[FFT]")
+{
+  Index const M = 128, nC = 8;
+  Cx5         x(M, M, M, nC, 1);
+  x.setRandom();
+  Cx5Map xm(x.data(), x.dimensions());
+  FFT::SetPlanCache(false);
+  BENCHMARK("FFT Forward 128^3 x8 Uncached") { FFT::Forward(xm, Sz3{0, 1, 2}); };
+  FFT::SetPlanCache(true);
+  BENCHMARK("FFT Forward 128^3 x8") { FFT::Forward(xm, Sz3{0, 1, 2}); };
+  BENCHMARK("FFT Adjoint 128^3 x8") { FFT::Adjoint(xm, Sz3{0, 1, 2}); };
+}
+
+TEST_CASE("FFT-Batch", "[FFT]")
+{
+  /* Calibration-region sized transforms over many channels */
+  Index const M = 32, nC = 32;
+  Cx5         x(M, M, M, nC, 1);
+  x.setRandom();
+  Cx5Map xm(x.data(), x.dimensions());
+  BENCHMARK("FFT Forward 32^3 x32") { FFT::Forward(xm, Sz3{0, 1, 2}); };
+  BENCHMARK("FFT ForwardBatch 32^3 x32") { FFT::ForwardBatch(xm, Sz3{0, 1, 2}, 3); };
+}
@@ -0,0 +1,47 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include "rl/algo/decomp.hpp"
+#include "rl/prox/llr.hpp"
+#include "rl/tensors.hpp"
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace rl;
+using namespace Catch;
+
+TEST_CASE("LLR", "[LLR]")
+{
+  using CMap = Proxs::LLR::CMap;
+  using Map = Proxs::LLR::Map;
+  Index const nB = 4, p = 5, nT = 8;
+
+  // One patch covering the whole volume so the prox can be checked against a direct SVD
+  Sz5 const  shape{nB, p, p, p, nT};
+  Cx5        x(shape), z(shape);
+  x.setRandom();
+  auto const X = CollapseToConstMatrix(x);
+
+  Proxs::LLR llr(1.f, p, p, false, shape);
+  float const λ = llr.λ;
+
+  BENCHMARK("SVD") { return SVD<Cx>(X.transpose()); };
+  BENCHMARK("Gram")
+  {
+    Eigen::MatrixXcd const Xd = X.cast<Cxd>();
+    return Eig<Cxd>(Xd * Xd.adjoint());
+  };
+  BENCHMARK("Prox") { llr.apply(1.f, CMap(x.data(), x.size()), Map(z.data(), z.size())); };
+
+  auto const             svd = SVD<Cx>(X.transpose());
+  Eigen::VectorXf const  s = (svd.S > λ).select(svd.S - λ, 0.f);
+  Eigen::MatrixXcf const ref = (svd.U * s.asDiagonal() * svd.V.adjoint()).transpose();
+  INFO("λ " << λ << " S " << svd.S.transpose());
+  CHECK((CollapseToConstMatrix(z) - ref).norm() == Approx(0.f).margin(1.e-4f * ref.norm()));
+
+  Sz5 const  volume{nB, 64, 64, 64, 1};
+  Cx5        xv(volume), zv(volume);
+  xv.setRandom();
+  Proxs::LLR llrv(1.f, p, 1, false, volume);
+  BENCHMARK("Prox Volume") { llrv.apply(1.f, CMap(xv.data(), xv.size()), Map(zv.data(), zv.size())); };
+}
@@ -0,0 +1,31 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include "rl/algo/common.hpp"
+#include "rl/log.hpp"
+#include "rl/sys/threads.hpp"
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace rl;
+
+namespace {
+void Axpby(Index const sz)
+{
+  Eigen::VectorXcf x(sz), y(sz);
+  x.setRandom();
+  y.setRandom();
+  float const a = 0.5f, b = 2.f;
+
+  BENCHMARK(fmt::format("Axpby Device {}", sz)) { y.device(Threads::CoreDevice()) = a * x + b * y; };
+  BENCHMARK(fmt::format("Axpby ParallelMap {}", sz))
+  {
+    Threads::ParallelMap(sz, [&](Index const lo, Index const hi) {
+      y.segment(lo, hi - lo) = a * x.segment(lo, hi - lo) + b * y.segment(lo, hi - lo);
+    });
+  };
+}
+} // namespace
+
+TEST_CASE("Map-Small", "[Map]") { Axpby(4096); }
+
+TEST_CASE("Map-Large", "[Map]") { Axpby(256 * 256 * 256 * 4); }
@@ -1,6 +1,7 @@
 #define CATCH_CONFIG_ENABLE_BENCHMARKING
 
 #include "rl/algo/common.hpp"
+#include "rl/algo/reduce.hpp"
 #include <catch2/benchmark/catch_benchmark_all.hpp>
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
@@ -13,16 +14,26 @@ TEST_CASE("Norms", "[Norm]")
   Eigen::VectorXcf x(sz);
   x.setRandom();
 
-  float sn = 0.f, n = 0.f, pn = 0.f;
+  float  sn = 0.f, n = 0.f, pn = 0.f;
+  double cn = 0.;
 
   BENCHMARK("Stable Norm") { sn = x.stableNorm(); };
   BENCHMARK("Norm") { n = x.norm(); };
+  BENCHMARK(fmt::format("Compensated Norm {}", rl::CompensatedISA())) { cn = std::sqrt(rl::CompensatedNorm2(x.data(), sz)); };
   BENCHMARK("Parallel Norm") { pn = rl::ParallelNorm(x); };
 
-  INFO("Stable norm   " << sn << 
+  long double acc = 0.; // Reference without a double-precision copy of the vector
+  for (rl::Index ii = 0; ii < sz; ii++) {
+    acc += std::norm(std::complex<long double>(x[ii]));
+  }
+  double const ref = std::sqrt(acc);
+  INFO("Double norm   " << ref << 
+     "\nStable norm   " << sn << 
      "\nNorm          " << n << 
+     "\nComp Norm     " << cn <<
      "\nParallel Norm " << pn <<
      "\nThreshold     " << 1.e-6f * sz);
   CHECK(std::abs(n - sn) == Approx(0.f).margin(1.e-6f * sz));
   CHECK(std::abs(pn - sn) == Approx(0.f).margin(1.e-6f * sz));
+  CHECK(std::abs(cn - ref) <= std::abs(double(sn) - ref));
 }
@@ -1,6 +1,7 @@
 #include "rl/basis/basis.hpp"
 #include "rl/io/hd5.hpp"
 #include "rl/log.hpp"
+#include "rl/tensors.hpp"
 #include "rl/types.hpp"
 
 #include "inputs.hpp"
@@ -9,31 +10,47 @@ void main_frames(args::Subparser &parser)
 {
   args::Positional<std::string> oname(parser, "OUTPUT", "Name for the basis file");
 
-  args::ValueFlag<Index> tracesPerFrame(parser, "T", "Traces per frame", {"tpf"});
-  args::ValueFlag<Index> framesPerRep(parser, "T", "Frames per repitition", {"fpr"});
-  args::ValueFlag<Index> reps(parser, "R", "Repetitions", {"reps"});
-  args::ValueFlag<Index> startFrame(parser, "F", "Start frame", {"start"});
-  args::ValueFlag<Index> incFrame(parser, "F", "Frame increment", {"inc"}, 1);
-  args::ValueFlag<Index> retain(parser, "R", "Frames to retain", {"retain"});
+  args::ValueFlag<Index>       tracesPerFrame(parser, "T", "Traces per frame", {"tpf"});
+  args::ValueFlag<Index>       framesPerRep(parser, "T", "Frames per repitition", {"fpr"});
+  args::ValueFlag<Index>       reps(parser, "R", "Repetitions", {"reps"});
+  args::ValueFlag<Index>       startFrame(parser, "F", "Start frame", {"start"});
+  args::ValueFlag<Index>       incFrame(parser, "F", "Frame increment", {"inc"}, 1);
+  args::ValueFlag<Index>       retain(parser, "R", "Frames to retain", {"retain"});
+  args::ValueFlag<std::string> bins(parser, "F", "Read per-trace frame indices from file (-1 discards the trace)", {"bins"});
   ParseCommand(parser);
   auto const cmd = parser.GetCommand().Name();
   if (!oname) { throw args::Error("No output filename specified"); }
 
-  Index const nF = reps ? reps.Get() : framesPerRep.Get();
-  Index const nT = tracesPerFrame.Get() * framesPerRep.Get() * (reps ? reps.Get() : 1);
-  Index       index = startFrame ? startFrame.Get() * tracesPerFrame.Get() : 0;
-  rl::Log::Print(cmd, "Frames {} Traces {}", nF, nT);
-  rl::Re3 basis(nF, 1, nT);
-  basis.setZero();
-  for (Index ifr = 0; ifr < nF; ifr++) {
-    for (Index it = 0; it < tracesPerFrame.Get(); it++) {
-      if (index >= nT) { throw rl::Log::Failure(cmd, "Trace index {} exceeded maximum {}", index, nT); }
-      basis(ifr, 0, index++) = 1.;
+  rl::Re3 basis;
+  if (bins) {
+    rl::HD5::Reader reader(bins.Get());
+    rl::I1 const    index = reader.readTensor<rl::I1>(rl::HD5::Keys::Data);
+    Index const     nT = index.dimension(0);
+    Index const     nF = rl::Maximum(index) + 1;
+    if (nF < 1) { throw rl::Log::Failure(cmd, "No traces were assigned to a frame"); }
+    rl::Log::Print(cmd, "Frames {} Traces {}", nF, nT);
+    basis.resize(nF, 1, nT);
+    basis.setZero();
+    for (Index it = 0; it < nT; it++) {
+      if (index(it) >= 0) { basis(index(it), 0, it) = 1.; }
+    }
+  } else {
+    Index const nF = reps ? reps.Get() : framesPerRep.Get();
+    Index const nT = tracesPerFrame.Get() * framesPerRep.Get() * (reps ? reps.Get() : 1);
+    Index       index = startFrame ? startFrame.Get() * tracesPerFrame.Get() : 0;
+    rl::Log::Print(cmd, "Frames {} Traces {}", nF, nT);
+    basis.resize(nF, 1, nT);
+    basis.setZero();
+    for (Index ifr = 0; ifr < nF; ifr++) {
+      for (Index it = 0; it < tracesPerFrame.Get(); it++) {
+        if (index >= nT) { throw rl::Log::Failure(cmd, "Trace index {} exceeded maximum {}", index, nT); }
+        basis(ifr, 0, index++) = 1.;
+      }
+      if (incFrame) { index += incFrame.Get() * tracesPerFrame.Get(); }
     }
-    if (incFrame) { index += incFrame.Get() * tracesPerFrame.Get(); }
   }
 
-  if (retain) { basis = rl::Re3(basis.slice(rl::Sz3{0, 0, 0}, rl::Sz3{retain.Get(), 1, nT})); }
+  if (retain) { basis = rl::Re3(basis.slice(rl::Sz3{0, 0, 0}, rl::Sz3{retain.Get(), 1, basis.dimension(2)})); }
 
   rl::HD5::Writer writer(oname.Get());
   writer.writeTensor(rl::HD5::Keys::Basis, basis.dimensions(), basis.data(), rl::HD5::Dims::Basis);
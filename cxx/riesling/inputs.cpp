@@ -3,6 +3,8 @@
 #include "rl/basis/basis.hpp"
 #include "rl/io/hd5.hpp"
 #include "rl/log.hpp"
+#include "rl/op/op.hpp"
+#include "rl/sys/scratch.hpp"
 #include "rl/sys/threads.hpp"
 #include "rl/tensors.hpp"
 
@@ -46,31 +48,45 @@ template struct GridArgs<3>;
 ReconArgs::ReconArgs(args::Subparser &parser)
   : decant(parser, "D", "Direct Virtual Coil (SENSE via convolution)", {"decant"})
   , lowmem(parser, "L", "Low memory mode", {"lowmem", 'l'})
+  , stack(parser, "S", "Require stack-of-stars NUFFT (FFT along z + 2D NUFFT)", {"stack"})
 {
 }
 
-auto ReconArgs::Get() -> rl::Recon::Opts { return rl::Recon::Opts{.decant = decant.Get(), .lowmem = lowmem.Get()}; }
+auto ReconArgs::Get() -> rl::Recon::Opts
+{
+  return rl::Recon::Opts{.decant = decant.Get(), .lowmem = lowmem.Get(), .stack = stack.Get()};
+}
 
 PreconArgs::PreconArgs(args::Subparser &parser)
-  : type(parser, "P", "Pre-conditioner (none/single/multi/filename)", {"precon"}, "single")
+  : type(parser, "P", "Pre-conditioner (none/single/multi/dcf/filename)", {"precon"}, "single")
   , λ(parser, "BIAS", "Pre-conditioner regularization (1)", {"precon-lambda"}, 1.e-3f)
 {
 }
 
 auto PreconArgs::Get() -> rl::PreconOpts { return rl::PreconOpts{.type = type.Get(), .λ = λ.Get()}; }
 
+MultiresArgs::MultiresArgs(args::Subparser &parser)
+  : levels(parser, "L", "Coarse-to-fine warm start levels (0)", {"multires"}, 0)
+  , its(parser, "N", "LSMR iterations per coarse level (4)", {"multires-its"}, 4)
+{
+}
+
+auto MultiresArgs::Get() -> rl::MultiresOpts { return rl::MultiresOpts{.levels = levels.Get(), .its = its.Get()}; }
+
 LSMRArgs::LSMRArgs(args::Subparser &parser)
   : its(parser, "N", "Max iterations (4)", {'i', "max-its"}, 4)
   , atol(parser, "A", "Tolerance on A (1e-6)", {"atol"}, 1.e-6f)
   , btol(parser, "B", "Tolerance on b (1e-6)", {"btol"}, 1.e-6f)
   , ctol(parser, "C", "Tolerance on cond(A) (1e-6)", {"ctol"}, 1.e-6f)
   , λ(parser, "λ", "Tikhonov parameter (default 0)", {"lambda"}, 0.f)
+  , bf16(parser, "B", "Store LSMR search directions as bfloat16", {"bf16"})
 {
 }
 
 auto LSMRArgs::Get() -> rl::LSMR::Opts
 {
-  return rl::LSMR::Opts{.imax = its.Get(), .aTol = atol.Get(), .bTol = btol.Get(), .cTol = ctol.Get(), .λ = λ.Get()};
+  return rl::LSMR::Opts{
+    .imax = its.Get(), .aTol = atol.Get(), .bTol = btol.Get(), .cTol = ctol.Get(), .λ = λ.Get(), .bf16 = bf16.Get()};
 }
 
 ADMMArgs::ADMMArgs(args::Subparser &parser)
@@ -85,6 +101,8 @@ ADMMArgs::ADMMArgs(args::Subparser &parser)
   , μ(parser, "μ", "Residual balancing tolerance (default 1.2)", {"mu"}, 1.2f)
   , τ(parser, "τ", "Residual balancing ratio limit (default 10)", {"tau"}, 10.f)
   , ɑ(parser, "ɑ", "Over-relaxation parameter (choose 1<ɑ<2)", {"alpha"}, 0.f)
+  , inexact(parser, "I", "Tie inner tolerance to ADMM residuals (inexact ADMM)", {"inexact"})
+  , fastRes(parser, "F", "Measure dual residuals without the regularizer adjoints", {"fast-residuals"})
 {
 }
 
@@ -101,7 +119,9 @@ auto ADMMArgs::Get() -> rl::ADMM::Opts
                         .balance = !ρ,
                         .μ = μ.Get(),
                         .τmax = τ.Get(),
-                        .ɑ = ɑ.Get()};
+                        .ɑ = ɑ.Get(),
+                        .inexact = inexact.Get(),
+                        .exactResiduals = !fastRes.Get()};
 }
 
 args::Group                      global_group("GLOBAL OPTIONS");
@@ -109,6 +129,9 @@ args::HelpFlag                   help(global_group, "H", "Show this help message
 args::MapFlag<int, Log::Display> verbosity(global_group, "V", "Log level 0-3", {'v', "verbosity"}, levelMap, Log::Display::Low);
 args::ValueFlag<std::string>     debug(global_group, "F", "Write debug images to file", {"debug"});
 args::ValueFlag<Index>           nthreads(global_group, "N", "Limit number of threads", {"nthreads"});
+args::Flag                       numa(global_group, "NUMA", "Bind threads to cores and interleave shared data across nodes", {"numa"});
+args::Flag                       concurrent(global_group, "C", "Run independent operator blocks concurrently", {"concurrent"});
+args::ValueFlag<float>           memGB(global_group, "GB", "Memory budget for NUFFT grids, larger grids go out-of-core", {"mem"});
 
 void SetLogging(std::string const &name)
 {
@@ -128,6 +151,13 @@ void SetThreadCount()
   } else if (char *const env_p = std::getenv("RL_THREADS")) {
     Threads::SetGlobalThreadCount(std::atoi(env_p));
   }
+  if (numa || std::getenv("RL_NUMA")) { Threads::SetNUMA(true); }
+  if (concurrent) { Ops::SetConcurrentStacks(true); }
+  if (memGB) {
+    SetMemoryBudget(memGB.Get() * 1e9);
+  } else if (char *const env_p = std::getenv("RL_MEM")) {
+    SetMemoryBudget(std::atof(env_p) * 1e9);
+  }
 }
 
 void ParseCommand(args::Subparser &parser)
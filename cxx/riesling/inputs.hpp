@@ -4,6 +4,7 @@
 
 #include "rl/algo/admm.hpp"
 #include "rl/algo/lsmr.hpp"
+#include "rl/multires.hpp"
 #include "rl/op/grid-opts.hpp"
 #include "rl/op/recon.hpp"
 #include "rl/precon.hpp"
@@ -41,7 +42,7 @@ template <int ND> struct GridArgs
 
 struct ReconArgs
 {
-  args::Flag decant, lowmem;
+  args::Flag decant, lowmem, stack;
   ReconArgs(args::Subparser &parser);
   auto Get() -> rl::Recon::Opts;
 };
@@ -54,6 +55,13 @@ struct PreconArgs
   auto Get() -> rl::PreconOpts;
 };
 
+struct MultiresArgs
+{
+  args::ValueFlag<Index> levels, its;
+  MultiresArgs(args::Subparser &parser);
+  auto Get() -> rl::MultiresOpts;
+};
+
 struct LSMRArgs
 {
   LSMRArgs(args::Subparser &parser);
@@ -62,6 +70,7 @@ struct LSMRArgs
   args::ValueFlag<float> btol;
   args::ValueFlag<float> ctol;
   args::ValueFlag<float> λ;
+  args::Flag             bf16;
   auto                   Get() -> rl::LSMR::Opts;
 };
 
@@ -83,6 +92,8 @@ struct ADMMArgs
   args::ValueFlag<float> τ;
 
   args::ValueFlag<float> ɑ;
+  args::Flag             inexact;
+  args::Flag             fastRes;
 
   auto Get() -> rl::ADMM::Opts;
 };
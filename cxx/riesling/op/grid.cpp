@@ -24,9 +24,8 @@ auto MakeGrid(
     return timeLoop;
   } else {
     auto loop = TOps::MakeLoop(grid, nS);
-    auto slabToVol = std::make_shared<TOps::Multiplex<Cx, 5>>(grid->ishape, nS);
-    auto compose1 = TOps::MakeCompose(slabToVol, loop);
-    auto timeLoop = TOps::MakeLoop(compose1, nT);
+    auto slabToVol = TOps::MakeMultiplex(loop, nS);
+    auto timeLoop = TOps::MakeLoop(slabToVol, nT);
     return timeLoop;
   }
 }
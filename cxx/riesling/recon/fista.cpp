@@ -0,0 +1,87 @@
+#include "inputs.hpp"
+#include "outputs.hpp"
+#include "regularizers.hpp"
+
+#include "rl/algo/eig.hpp"
+#include "rl/algo/fista.hpp"
+#include "rl/io/hd5.hpp"
+#include "rl/io/norm-cache.hpp"
+#include "rl/log.hpp"
+#include "rl/op/pad.hpp"
+#include "rl/op/recon.hpp"
+#include "rl/precon.hpp"
+#include "rl/scaling.hpp"
+#include "rl/sense/sense.hpp"
+
+using namespace rl;
+
+void main_recon_fista(args::Subparser &parser)
+{
+  CoreArgs                     coreArgs(parser);
+  GridArgs<3>                  gridArgs(parser);
+  PreconArgs                   preArgs(parser);
+  ReconArgs                    reconArgs(parser);
+  SENSEArgs                    senseArgs(parser);
+  RegOpts                      regOpts(parser);
+  args::ValueFlag<std::string> scaling(parser, "S", "Data scaling (otsu/bart/number)", {"scale"}, "otsu");
+  args::ValueFlag<Index>       its(parser, "ITS", "Max iterations (32)", {"max-its"}, 32);
+  args::ValueFlag<float>       ε(parser, "ε", "Tolerance on relative change in x (1e-4)", {"eps"}, 1.e-4f);
+  args::ValueFlag<float>       L(parser, "L", "Lipschitz constant, calculated if not given", {"lipschitz"}, -1.f);
+  args::ValueFlag<std::string> normCache(parser, "F", "Cache the Lipschitz constant in this file", {"norm-cache"});
+  args::Flag                   noRestart(parser, "R", "Disable gradient restarts", {"no-restart"});
+  args::Flag                   pogm(parser, "P", "Use POGM instead of FISTA", {"pogm"});
+  args::ValueFlag<Index>       debugIters(parser, "I", "Write debug images ever N iterations (16)", {"debug-iters"}, 16);
+  ArrayFlag<float, 3>          cropFov(parser, "FOV", "Crop FoV in mm (x,y,z)", {"crop-fov"}, Eigen::Array3f::Zero());
+
+  ParseCommand(parser, coreArgs.iname, coreArgs.oname);
+  auto const  cmd = parser.GetCommand().Name();
+  HD5::Reader reader(coreArgs.iname.Get());
+  Info const  info = reader.readInfo();
+  Trajectory  traj(reader, info.voxel_size, coreArgs.matrix.Get());
+  auto        noncart = reader.readTensor<Cx5>();
+  traj.checkDims(FirstN<3>(noncart.dimensions()));
+
+  auto const  basis = LoadBasis(coreArgs.basisFile.Get());
+  auto const  skern = noncart.dimension(0) > 1 ? SENSE::Choose(senseArgs.Get(), gridArgs.Get(), traj, noncart) : Cx5();
+  auto const  R = Recon(reconArgs.Get(), preArgs.Get(), gridArgs.Get(), skern, traj, basis.get(), noncart);
+  auto const  shape = R.A->ishape;
+  float const scale = ScaleData(scaling.Get(), R.A, R.M, CollapseToVector(noncart));
+  if (scale != 1.f) { noncart.device(Threads::TensorDevice()) = noncart * Cx(scale); }
+  auto [reg, A, ext_x] = Regularizers(regOpts, R.A);
+  if (reg.size() != 1 || reg[0].T || ext_x) {
+    throw Log::Failure(cmd, "Requires exactly one regularizer with a direct prox, e.g. --l1, --wavelets or --llr");
+  }
+
+  FISTA::Opts opts{.imax = its.Get(), .ε = ε.Get(), .L = L.Get(), .restart = !noRestart};
+  if (normCache && opts.L <= 0.f) {
+    /* The kernel is fixed at compile time so does not need to be part of the key. The data scaling does not change the
+     * operator norm. */
+    auto const   gOpts = gridArgs.Get();
+    auto const   pOpts = preArgs.Get();
+    HD5::NormKey key;
+    key.add(traj.points()).add(traj.matrix()).add(gOpts.fov).add(gOpts.osamp).add(pOpts.type).add(pOpts.λ).add(skern);
+    if (basis) { key.add(basis->B); }
+    key.add(A->rows()).add(A->cols());
+    if (auto const cached = HD5::ReadNorm(normCache.Get(), key)) {
+      opts.L = *cached;
+    } else {
+      auto const l = Lanczos(A, R.M, 32);
+      opts.L = l.val + l.err;
+      HD5::WriteNorm(normCache.Get(), key, opts.L);
+    }
+  }
+
+  FISTA::DebugX debug_x = [shape, di = debugIters.Get()](Index const ii, FISTA::Vector const &x) {
+    if (ii % di == 0) { Log::Tensor(fmt::format("fista-x-{:02d}", ii), shape, x.data(), HD5::Dims::Image); }
+  };
+  auto const b = CollapseToConstVector(noncart);
+  auto       x = pogm ? POGM{A, R.M, reg[0].P, opts, debug_x}.run(b) : FISTA{A, R.M, reg[0].P, opts, debug_x}.run(b);
+  if (scale != 1.f) { x.device(Threads::CoreDevice()) = x / Cx(scale); }
+  auto const xm = AsConstTensorMap(x, R.A->ishape);
+
+  TOps::Pad<Cx, 5> oc(traj.matrixForFOV(cropFov.Get(), shape[3], shape[4]), R.A->ishape);
+  auto             out = oc.adjoint(xm);
+  if (basis) { basis->applyR(out); }
+  WriteOutput(cmd, coreArgs.oname.Get(), out, HD5::Dims::Image, info);
+  Log::Print(cmd, "Finished");
+}
@@ -20,6 +20,7 @@ void main_recon_lsq(args::Subparser &parser)
   ReconArgs              reconArgs(parser);
   SENSEArgs              senseArgs(parser);
   LSMRArgs               lsqOpts(parser);
+  MultiresArgs           multiresArgs(parser);
   ArrayFlag<float, 3>    cropFov(parser, "FOV", "Crop FoV in mm (x,y,z)", {"crop-fov"}, Eigen::Array3f::Zero());
   args::ValueFlag<Index> debugIters(parser, "I", "Write debug images ever N iterations (1)", {"debug-iters"}, 1);
   ParseCommand(parser, coreArgs.iname, coreArgs.oname);
@@ -31,14 +32,17 @@ void main_recon_lsq(args::Subparser &parser)
   traj.checkDims(FirstN<3>(noncart.dimensions()));
 
   auto const basis = LoadBasis(coreArgs.basisFile.Get());
-  auto const R = Recon(reconArgs.Get(), preArgs.Get(), gridArgs.Get(), senseArgs.Get(), traj, basis.get(), noncart);
+  auto const skern = noncart.dimension(0) > 1 ? SENSE::Choose(senseArgs.Get(), gridArgs.Get(), traj, noncart) : Cx5();
+  auto const R = Recon(reconArgs.Get(), preArgs.Get(), gridArgs.Get(), skern, traj, basis.get(), noncart);
   Log::Debug(cmd, "A {} {} M {}", R.A->ishape, R.A->oshape, R.M->ishape);
   auto debug = [shape = R.A->ishape, d = debugIters.Get()](Index const i, LSMR::Vector const &x) {
     if (i % d == 0) { Log::Tensor(fmt::format("lsmr-x-{:02d}", i), shape, x.data(), HD5::Dims::Image); }
   };
   LSMR lsmr{R.A, R.M, nullptr, lsqOpts.Get(), debug};
 
-  auto const x = lsmr.run(CollapseToConstVector(noncart));
+  auto const x0 = MultiresWarmStart(multiresArgs.Get(), reconArgs.Get(), preArgs.Get(), gridArgs.Get(), skern, traj, basis.get(),
+                                    noncart, R.A->ishape);
+  auto const x = lsmr.run(CollapseToConstVector(noncart), CollapseToConstVector(x0));
   auto const xm = AsTensorMap(x, R.A->ishape);
 
   TOps::Pad<Cx, 5> oc(traj.matrixForFOV(cropFov.Get(), R.A->ishape[3], R.A->ishape[4]), R.A->ishape);
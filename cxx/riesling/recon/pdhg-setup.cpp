@@ -1,43 +1,43 @@
-#include "types.hpp"
-
-#include "algo/eig.hpp"
-#include "algo/pdhg.hpp"
 #include "inputs.hpp"
-#include "io/hd5.hpp"
-#include "log.hpp"
-#include "op/recon.hpp"
-#include "precon.hpp"
 #include "regularizers.hpp"
-#include "scaling.hpp"
-#include "sense/sense.hpp"
+
+#include "rl/algo/pdhg.hpp"
+#include "rl/io/hd5.hpp"
+#include "rl/log.hpp"
+#include "rl/op/recon.hpp"
+#include "rl/precon.hpp"
+#include "rl/sense/sense.hpp"
 
 using namespace rl;
 
-void main_pdhg_setup(args::Subparser &parser)
+void main_recon_pdhg_setup(args::Subparser &parser)
 {
   CoreArgs    coreArgs(parser);
-  GridOpts    gridOpts(parser);
-  PreconOpts  preOpts(parser);
-  SENSE::Opts senseOpts(parser);
+  GridArgs<3> gridArgs(parser);
+  PreconArgs  preArgs(parser);
+  ReconArgs   reconArgs(parser);
+  SENSEArgs   senseArgs(parser);
   RegOpts     regOpts(parser);
 
-  ParseCommand(parser, coreArgs.iname);
-
+  ParseCommand(parser, coreArgs.iname, coreArgs.oname);
+  auto const  cmd = parser.GetCommand().Name();
   HD5::Reader reader(coreArgs.iname.Get());
-  Trajectory  traj(reader, reader.readInfo().voxel_size);
+  Info const  info = reader.readInfo();
+  Trajectory  traj(reader, info.voxel_size, coreArgs.matrix.Get());
   auto        noncart = reader.readTensor<Cx5>();
-  auto const  nS = noncart.dimension(3);
-  auto const  nT = noncart.dimension(4);
-  auto const  basis = ReadBasis(coreArgs.basisFile.Get());
-  auto const  recon = Recon::SENSE(coreArgs.ndft, gridOpts, senseOpts, traj, nS, nT, basis, noncart);
-  auto const  shape = recon->ishape;
-  auto const  P =
-    make_kspace_pre(traj, recon->oshape[0], ReadBasis(coreArgs.basisFile.Get()), preOpts.type.Get(), preOpts.bias.Get());
-
-  std::shared_ptr<Ops::Op<Cx>> A = recon; // TGV needs a special A
-  Regularizers                 reg(regOpts, shape, A);
-
-  PDHG pdhg(A, P, reg.regs);
-
-  fmt::print("{:4.3E}\n{:4.3E}", fmt::join(pdhg.σ, ","), pdhg.τ);
+  traj.checkDims(FirstN<3>(noncart.dimensions()));
+
+  auto const basis = LoadBasis(coreArgs.basisFile.Get());
+  auto const skern = noncart.dimension(0) > 1 ? SENSE::Choose(senseArgs.Get(), gridArgs.Get(), traj, noncart) : Cx5();
+  auto const R = Recon(reconArgs.Get(), preArgs.Get(), gridArgs.Get(), skern, traj, basis.get(), noncart);
+  auto [reg, A, ext_x] = Regularizers(regOpts, R.A);
+
+  // The operator norms only depend on the trajectory, SENSE maps and regularizer operators, not the data
+  PDHG           pdhg(A, R.M, reg, PDHG::Opts{});
+  Eigen::ArrayXf τσ(pdhg.σ.size() + 1);
+  τσ[0] = pdhg.τ;
+  std::copy(pdhg.σ.begin(), pdhg.σ.end(), τσ.data() + 1);
+  HD5::Writer writer(coreArgs.oname.Get());
+  writer.writeMatrix(τσ, "pdhg");
+  Log::Print(cmd, "τ {:4.3E} σ {:4.3E}", pdhg.τ, fmt::join(pdhg.σ, ","));
 }
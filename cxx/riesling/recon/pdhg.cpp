@@ -1,69 +1,73 @@
-#include "types.hpp"
-
-#include "algo/eig.hpp"
-#include "algo/pdhg.hpp"
 #include "inputs.hpp"
-#include "io/hd5.hpp"
-#include "log.hpp"
-#include "op/recon.hpp"
-#include "precon.hpp"
+#include "outputs.hpp"
 #include "regularizers.hpp"
-#include "scaling.hpp"
-#include "sense/sense.hpp"
+
+#include "rl/algo/pdhg.hpp"
+#include "rl/io/hd5.hpp"
+#include "rl/log.hpp"
+#include "rl/op/pad.hpp"
+#include "rl/op/recon.hpp"
+#include "rl/precon.hpp"
+#include "rl/scaling.hpp"
+#include "rl/sense/sense.hpp"
 
 using namespace rl;
 
-void main_pdhg(args::Subparser &parser)
+void main_recon_pdhg(args::Subparser &parser)
 {
-  CoreArgs    coreArgs(parser);
-  GridOpts    gridOpts(parser);
-  PreconOpts  preOpts(parser);
-  SENSE::Opts senseOpts(parser);
-  RegOpts     regOpts(parser);
-
+  CoreArgs                     coreArgs(parser);
+  GridArgs<3>                  gridArgs(parser);
+  PreconArgs                   preArgs(parser);
+  ReconArgs                    reconArgs(parser);
+  SENSEArgs                    senseArgs(parser);
+  RegOpts                      regOpts(parser);
   args::ValueFlag<std::string> scaling(parser, "S", "Data scaling (otsu/bart/number)", {"scale"}, "otsu");
-  args::ValueFlag<Index>       its(parser, "ITS", "Max iterations (4)", {"max-its"}, 4);
-  args::ValueFlag<std::vector<float>, VectorReader<float>> σin(parser, "σ", "Pre-computed dual step sizes", {"sigma"});
-  args::ValueFlag<float>                                   τin(parser, "τ", "Pre-computed primal step size", {"tau"}, -1.f);
-  ParseCommand(parser, coreArgs.iname, coreArgs.oname);
+  args::ValueFlag<Index>       its(parser, "ITS", "Max iterations (64)", {"max-its"}, 64);
+  args::ValueFlag<float>       ε(parser, "ε", "Relative residual tolerance (1e-3)", {"eps"}, 1.e-3f);
+  args::Flag                   noBalance(parser, "B", "Disable adaptive step balancing", {"no-balance"});
+  args::ValueFlag<std::string> steps(parser, "F", "Read step sizes from recon-pdhg-setup output", {"steps"});
+  args::ValueFlag<Index>       debugIters(parser, "I", "Write debug images ever N iterations (16)", {"debug-iters"}, 16);
+  ArrayFlag<float, 3>          cropFov(parser, "FOV", "Crop FoV in mm (x,y,z)", {"crop-fov"}, Eigen::Array3f::Zero());
 
+  ParseCommand(parser, coreArgs.iname, coreArgs.oname);
+  auto const  cmd = parser.GetCommand().Name();
   HD5::Reader reader(coreArgs.iname.Get());
   Info const  info = reader.readInfo();
-  Trajectory  traj(reader, info.voxel_size);
+  Trajectory  traj(reader, info.voxel_size, coreArgs.matrix.Get());
   auto        noncart = reader.readTensor<Cx5>();
   traj.checkDims(FirstN<3>(noncart.dimensions()));
-  Index const nS = noncart.dimension(3);
-  Index const nV = noncart.dimension(4);
 
-  auto const basis = ReadBasis(coreArgs.basisFile.Get());
-  auto const recon = Recon::SENSE(coreArgs, gridOpts, senseOpts, traj, nS, basis, noncart);
-  auto const shape = recon->ishape;
-  auto const P =
-    make_kspace_pre(traj, recon->oshape[0], ReadBasis(coreArgs.basisFile.Get()), preOpts.type.Get(), preOpts.bias.Get());
+  auto const  basis = LoadBasis(coreArgs.basisFile.Get());
+  auto const  skern = noncart.dimension(0) > 1 ? SENSE::Choose(senseArgs.Get(), gridArgs.Get(), traj, noncart) : Cx5();
+  auto const  R = Recon(reconArgs.Get(), preArgs.Get(), gridArgs.Get(), skern, traj, basis.get(), noncart);
+  auto const  shape = R.A->ishape;
+  float const scale = ScaleData(scaling.Get(), R.A, R.M, CollapseToVector(noncart));
+  if (scale != 1.f) { noncart.device(Threads::TensorDevice()) = noncart * Cx(scale); }
+  auto [reg, A, ext_x] = Regularizers(regOpts, R.A);
 
-  std::shared_ptr<Ops::Op<Cx>> A = recon; // TGV needs a special A
-  Regularizers                 reg(regOpts, shape, A);
-
-  std::function<void(Index const, PDHG::Vector const &, PDHG::Vector const &, PDHG::Vector const &)> debug_x =
-    [shape](Index const ii, PDHG::Vector const &x, PDHG::Vector const &x̅, PDHG::Vector const &xdiff) {
-      Log::Tensor(fmt::format("pdhg-x-{:02d}", ii), shape, x.data());
-      Log::Tensor(fmt::format("pdhg-xbar-{:02d}", ii), shape, x̅.data());
-      Log::Tensor(fmt::format("pdhg-xdiff-{:02d}", ii), shape, xdiff.data());
-    };
-
-  PDHG pdhg(A, P, reg.regs, σin.Get(), τin.Get(), debug_x);
+  PDHG::Opts opts{.imax = its.Get(), .ε = ε.Get(), .balance = !noBalance};
+  if (steps) {
+    HD5::Reader          stepReader(steps.Get());
+    Eigen::ArrayXf const τσ = stepReader.readMatrix<Eigen::ArrayXf>("pdhg");
+    if (τσ.size() != static_cast<Index>(reg.size()) + 1) {
+      throw Log::Failure(cmd, "Step file has {} regularizer steps, expected {}", τσ.size() - 1, reg.size());
+    }
+    opts.τ = τσ[0];
+    opts.σ = std::vector<float>(τσ.data() + 1, τσ.data() + τσ.size());
+  }
 
-  TOps::Crop<Cx, 4> oc(recon->ishape, AddFront(traj.matrixForFOV(coreArgs.fov.Get()), recon->ishape[0]));
-  Cx5               out(AddBack(oc.oshape, nV));
+  PDHG::DebugX debug_x = [shape, di = debugIters.Get()](Index const ii, PDHG::Vector const &x) {
+    if (ii % di == 0) { Log::Tensor(fmt::format("pdhg-x-{:02d}", ii), shape, x.data(), HD5::Dims::Image); }
+  };
+  PDHG pdhg(A, R.M, reg, opts, debug_x);
 
-  float const scale = Scaling(scaling, recon, P, &noncart(0, 0, 0, 0, 0));
-  noncart.device(Threads::GlobalDevice()) = noncart * noncart.constant(scale);
+  auto x = ext_x ? ext_x->forward(pdhg.run(CollapseToConstVector(noncart))) : pdhg.run(CollapseToConstVector(noncart));
+  if (scale != 1.f) { x.device(Threads::CoreDevice()) = x / Cx(scale); }
+  auto const xm = AsConstTensorMap(x, R.A->ishape);
 
-  for (Index iv = 0; iv < nV; iv++) {
-    auto x = pdhg.run(&noncart(0, 0, 0, 0, iv), its.Get());
-    auto xm = AsTensorMap(x, recon->ishape);
-    out.chip<4>(iv) = oc.forward(xm) / out.chip<4>(iv).constant(scale);
-  }
-  WriteOutput(cmd, coreArgs.oname.Get(), out, info);
-  rl::Log::Print(cmd, "Finished");
+  TOps::Pad<Cx, 5> oc(traj.matrixForFOV(cropFov.Get(), shape[3], shape[4]), R.A->ishape);
+  auto             out = oc.adjoint(xm);
+  if (basis) { basis->applyR(out); }
+  WriteOutput(cmd, coreArgs.oname.Get(), out, HD5::Dims::Image, info);
+  Log::Print(cmd, "Finished");
 }
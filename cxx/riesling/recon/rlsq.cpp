@@ -3,6 +3,7 @@
 #include "regularizers.hpp"
 
 #include "rl/algo/admm.hpp"
+#include "rl/io/checkpoint.hpp"
 #include "rl/io/hd5.hpp"
 #include "rl/log.hpp"
 #include "rl/op/pad.hpp"
@@ -21,11 +22,15 @@ void main_recon_rlsq(args::Subparser &parser)
   ReconArgs                    reconArgs(parser);
   SENSEArgs                    senseArgs(parser);
   ADMMArgs                     admmArgs(parser);
+  MultiresArgs                 multiresArgs(parser);
   RegOpts                      regOpts(parser);
   args::ValueFlag<std::string> scaling(parser, "S", "Data scaling (otsu/bart/number)", {"scale"}, "otsu");
   args::ValueFlag<Index>       debugIters(parser, "I", "Write debug images ever N outer iterations (16)", {"debug-iters"}, 16);
   args::Flag                   debugZ(parser, "Z", "Write regularizer debug images", {"debug-z"});
   ArrayFlag<float, 3>          cropFov(parser, "FOV", "Crop FoV in mm (x,y,z)", {"crop-fov"}, Eigen::Array3f::Zero());
+  args::ValueFlag<std::string> checkpoint(parser, "F", "Write solver checkpoints to file", {"checkpoint"});
+  args::ValueFlag<Index>       checkpointIters(parser, "N", "Checkpoint every N outer iterations (1)", {"checkpoint-its"}, 1);
+  args::Flag                   resume(parser, "R", "Resume from the checkpoint file", {"resume"});
 
   ParseCommand(parser, coreArgs.iname, coreArgs.oname);
   auto const  cmd = parser.GetCommand().Name();
@@ -36,7 +41,8 @@ void main_recon_rlsq(args::Subparser &parser)
   traj.checkDims(FirstN<3>(noncart.dimensions()));
 
   auto const  basis = LoadBasis(coreArgs.basisFile.Get());
-  auto const  R = Recon(reconArgs.Get(), preArgs.Get(), gridArgs.Get(), senseArgs.Get(), traj, basis.get(), noncart);
+  auto const  skern = noncart.dimension(0) > 1 ? SENSE::Choose(senseArgs.Get(), gridArgs.Get(), traj, noncart) : Cx5();
+  auto const  R = Recon(reconArgs.Get(), preArgs.Get(), gridArgs.Get(), skern, traj, basis.get(), noncart);
   auto const  shape = R.A->ishape;
   float const scale = ScaleData(scaling.Get(), R.A, R.M, CollapseToVector(noncart));
   if (scale != 1.f) { noncart.device(Threads::TensorDevice()) = noncart * Cx(scale); }
@@ -66,7 +72,31 @@ void main_recon_rlsq(args::Subparser &parser)
 
   ADMM opt{A, R.M, reg, admmArgs.Get(), debug_x, debug_z};
 
-  auto x = ext_x ? ext_x->forward(opt.run(CollapseToConstVector(noncart))) : opt.run(CollapseToConstVector(noncart));
+  std::unique_ptr<HD5::Checkpointer> checkpointer;
+  if (checkpoint) {
+    checkpointer = std::make_unique<HD5::Checkpointer>(checkpoint.Get(), checkpointIters.Get());
+    opt.checkpoint = [&checkpointer](Index const io, float const ρ, float const res, ADMM::Vector const &x,
+                                     std::vector<ADMM::Vector> const &z, std::vector<ADMM::Vector> const &u) {
+      (*checkpointer)(io, ρ, res, x, z, u);
+    };
+  }
+  if (resume) {
+    if (!checkpoint) { throw Log::Failure(cmd, "--resume requires --checkpoint"); }
+    opt.resume = HD5::ReadCheckpoint(checkpoint.Get());
+  }
+
+  ADMM::Vector x0;
+  if (multiresArgs.levels && !resume) {
+    if (ext_x) {
+      Log::Print(cmd, "Regularizers extend x, multiresolution warm start is not supported");
+    } else {
+      x0 = MultiresWarmStart(multiresArgs.Get(), reconArgs.Get(), preArgs.Get(), gridArgs.Get(), skern, traj, basis.get(),
+                             noncart, shape);
+    }
+  }
+  auto x = ext_x ? ext_x->forward(opt.run(CollapseToConstVector(noncart)))
+                 : opt.run(CollapseToConstVector(noncart), CollapseToConstVector(x0));
+  if (checkpointer) { checkpointer->wait(); }
   if (scale != 1.f) { x.device(Threads::CoreDevice()) = x / Cx(scale); }
   auto const xm = AsConstTensorMap(x, R.A->ishape);
 
@@ -9,11 +9,10 @@
 
 using namespace rl;
 
-auto Focus(Cx5 const &x) -> Cx5
+void Focus(Cx5 const &x, Cx5 &y)
 {
   Re1 const f = x.imag().abs().sum(Sz4{1, 2, 3, 4});
-  Cx5 const y = x.slice(Sz5{I0(f.argmin())(), 0, 0, 0, 0}, AddFront(LastN<4>(x.dimensions()), 1));
-  return y;
+  y = x.slice(Sz5{I0(f.argmin())(), 0, 0, 0, 0}, AddFront(LastN<4>(x.dimensions()), 1));
 }
 
 void main_autofocus(args::Subparser &parser)
@@ -31,8 +30,10 @@ void main_autofocus(args::Subparser &parser)
   Index const nT = in.dimension(4);
   Cx5         out(1, nX, nY, nZ, nT);
   Cx5Map      omap(out.data(), out.dimensions());
-  auto const &all_start = Log::Now();
-  Patches(patch.Get(), 1, false, Focus, in, omap);
+
+  PatchScratch scratch(patch.Get(), in.dimensions());
+  auto const  &all_start = Log::Now();
+  Patches(patch.Get(), 1, false, Focus, scratch, in, omap);
   Log::Print(cmd, "All Volumes: {}", Log::ToNow(all_start));
 
   HD5::Writer writer(oname.Get());
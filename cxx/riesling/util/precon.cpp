@@ -14,12 +14,17 @@ void main_precon(args::Subparser &parser)
   args::Positional<std::string> preFile(parser, "OUTPUT", "File to save pre-conditioner to");
   args::ValueFlag<float>        preλ(parser, "BIAS", "Pre-conditioner regularization (1)", {"lambda"}, 1.f);
   args::ValueFlag<std::string>  sfile(parser, "S", "Load SENSE kernels from file", {"sense"});
+  args::Flag                    dcf(parser, "D", "Calculate Pipe-Menon density compensation instead", {"dcf"});
+  args::ValueFlag<Index>        dcfIts(parser, "N", "Density compensation iterations (10)", {"dcf-its"}, 10);
   ParseCommand(parser, trajFile);
   auto const  cmd = parser.GetCommand().Name();
   HD5::Reader reader(trajFile.Get());
   HD5::Writer writer(preFile.Get());
   Trajectory  traj(reader, reader.readInfo().voxel_size);
-  if (sfile) {
+  if (dcf) {
+    auto const M = KSpaceDCF(gridArgs.Get(), traj, dcfIts.Get());
+    writer.writeTensor(HD5::Keys::Weights, M.dimensions(), M.data(), {"sample", "trace"});
+  } else if (sfile) {
     HD5::Reader senseReader(sfile.Get());
     Cx5 const   skern = senseReader.readTensor<Cx5>(HD5::Keys::Data);
     Cx5 const   smaps = SENSE::KernelsToMaps(skern, traj.matrixForFOV(gridArgs.fov.Get()), gridArgs.osamp.Get());
@@ -2,16 +2,58 @@
 
 #include "../log.hpp"
 #include "../op/top.hpp"
+#include "../sys/threads.hpp"
 #include "../tensors.hpp"
 #include "common.hpp"
 #include "iter.hpp"
 #include "lsmr.hpp"
 
+#include <numeric>
+
 namespace rl {
 
-auto ADMM::run(Vector const &b) const -> Vector { return run(CMap{b.data(), b.rows()}); }
+namespace {
+struct RegNorms
+{
+  float Fx = 0.f, z = 0.f, u = 0.f, P = 0.f, D = 0.f;
+};
+
+/*
+ * Call f(ir) for each regularizer. Under the same policy as concurrent operator stacks (see Ops::SetConcurrentStacks)
+ * these run as concurrent tasks sharing the thread pool, with the most expensive on the calling thread. A transform or
+ * prox that appears in more than one regularizer holds mutable workspaces, so in that case they run in turn. Only the T
+ * and P pointers themselves are compared, so two regularizers must not share an operator nested inside a composite
+ * transform or prox.
+ */
+template <typename F> void ForEachReg(std::vector<Regularizer> const &regs, F const &f)
+{
+  Index const R = regs.size();
+  bool        concurrent = Ops::ConcurrentStacks() && R > 1 && 2 * R <= Threads::GlobalThreadCount();
+  for (Index ii = 0; ii < R && concurrent; ii++) {
+    for (Index ij = ii + 1; ij < R; ij++) {
+      if ((regs[ii].T && regs[ii].T == regs[ij].T) || regs[ii].P == regs[ij].P) { concurrent = false; }
+    }
+  }
+  if (!concurrent) {
+    for (Index ir = 0; ir < R; ir++) {
+      f(ir);
+    }
+    return;
+  }
+  auto const cost = [&](Index const ir) { return regs[ir].T ? regs[ir].T->costEstimate() : float(regs[ir].P->sz); };
+  std::vector<Index> order(R);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](Index a, Index b) { return cost(a) > cost(b); });
+  Threads::CallerFirst(R, [&](Index const ii) { f(order[ii]); });
+}
+} // namespace
+
+auto ADMM::run(Vector const &b, Vector const &x0) const -> Vector
+{
+  return run(CMap{b.data(), b.rows()}, CMap{x0.data(), x0.rows()});
+}
 
-auto ADMM::run(CMap const b) const -> Vector
+auto ADMM::run(CMap const b, CMap x0) const -> Vector
 {
   /* See https://web.stanford.edu/~boyd/papers/admm/lasso/lasso_lsqr.html
    * For the least squares part we are solving:
@@ -39,9 +81,9 @@ auto ADMM::run(CMap const b) const -> Vector
   for (Index ir = 0; ir < R; ir++) {
     Index const sz = regs[ir].T ? regs[ir].T->rows() : A->cols();
     z[ir].resize(sz);
-    z[ir].setZero();
+    Threads::FirstTouch(z[ir].data(), sz);
     u[ir].resize(sz);
-    u[ir].setZero();
+    Threads::FirstTouch(u[ir].data(), sz);
     ρdiags[ir] = std::make_shared<Ops::DiagScale<Cx>>(sz, std::sqrt(ρ));
     scaled_ops[ir] = regs[ir].T
                        ? std::static_pointer_cast<Ops::Op<Cx>>(std::make_shared<Ops::Multiply<Cx>>(ρdiags[ir], regs[ir].T))
@@ -60,15 +102,50 @@ auto ADMM::run(CMap const b) const -> Vector
   LSMR lsmr{Aʹ, Minvʹ, nullptr, LSMR::Opts{opts.iters0, opts.aTol, opts.bTol, opts.cTol}};
 
   Vector x(A->cols());
-  x.setZero();
+  Index  io0 = 0;
+  float  res = 1.f; // Larger of the scaled primal and dual residuals from the previous outer iteration
+  if (resume) {
+    if (resume->x.rows() != A->cols()) {
+      throw Log::Failure("ADMM", "Checkpoint x was size {} expected {}", resume->x.rows(), A->cols());
+    }
+    if (static_cast<Index>(resume->z.size()) != R || static_cast<Index>(resume->u.size()) != R) {
+      throw Log::Failure("ADMM", "Checkpoint had {} regularizers expected {}", resume->z.size(), R);
+    }
+    for (Index ir = 0; ir < R; ir++) {
+      if (resume->z[ir].rows() != z[ir].rows() || resume->u[ir].rows() != u[ir].rows()) {
+        throw Log::Failure("ADMM", "Checkpoint regularizer {} had mismatched size", ir);
+      }
+      z[ir].device(dev) = resume->z[ir];
+      u[ir].device(dev) = resume->u[ir];
+    }
+    x.device(dev) = resume->x;
+    ρ = resume->ρ;
+    res = resume->res;
+    io0 = resume->io;
+    if (io0 > 0 && !opts.inexact) { lsmr.opts.imax = opts.iters1; }
+    Log::Print("ADMM", "Resuming at outer iteration {} ρ {}", io0, ρ);
+  } else if (x0.size()) {
+    if (x0.rows() != A->cols()) { throw Log::Failure("ADMM", "x0 was size {} expected {}", x0.rows(), A->cols()); }
+    x.device(dev) = x0;
+    // Start the splitting variables consistent with x0
+    for (Index ir = 0; ir < R; ir++) {
+      if (regs[ir].T) {
+        regs[ir].T->forward(x, z[ir]);
+      } else {
+        z[ir].device(dev) = x;
+      }
+    }
+  } else {
+    Threads::FirstTouch(x.data(), x.size());
+  }
 
   Vector bʹ(Aʹ->rows());
-  bʹ.setZero();
+  Threads::FirstTouch(bʹ.data(), bʹ.size());
   bʹ.head(A->rows()).device(dev) = b;
 
   Log::Print("ADMM", "Abs ε {}", opts.ε);
   Iterating::Starting();
-  for (Index io = 0; io < opts.outerLimit; io++) {
+  for (Index io = io0; io < opts.outerLimit; io++) {
     Index start = A->rows();
     for (Index ir = 0; ir < R; ir++) {
       Index rr = regs[ir].T ? regs[ir].T->rows() : A->cols();
@@ -76,18 +153,34 @@ auto ADMM::run(CMap const b) const -> Vector
       start += rr;
       ρdiags[ir]->scale = std::sqrt(ρ);
     }
+    if (opts.inexact) {
+      /* Inexact ADMM (Eckstein & Bertsekas 1992). The inner tolerance is a fixed fraction of the outer residual, so LSMR
+       * stops after one iteration while the x update is already accurate enough for ADMM to make progress, and runs up to
+       * iters0 only when it is not. Damping by the iteration count instead drives the tolerance to the aTol floor within
+       * a few outer iterations, after which every inner solve runs to iters0. */
+      float const tol = std::min(std::max(0.1f * res, opts.aTol), 0.1f);
+      lsmr.opts.aTol = tol;
+      lsmr.opts.bTol = tol;
+      Log::Print("ADMM", "Inner tolerance {:3.2E}", tol);
+    }
     x = lsmr.run(bʹ, x);
-    lsmr.opts.imax = opts.iters1;
+    if (!opts.inexact) { lsmr.opts.imax = opts.iters1; }
     if (debug_x) { debug_x(io, x); }
 
-    float normFx = 0.f, normz = 0.f, normu = 0.f, pRes = 0.f, dRes = 0.f;
-    for (Index ir = 0; ir < R; ir++) {
-      float  nz, nu, nP, nD;
+    float const normx = ParallelNorm(x);
+    /* Each regularizer only touches its own z and u, so they can be updated concurrently. The norms are kept per
+     * regularizer and summed in order afterwards so the result does not depend on scheduling. If exact residuals are
+     * turned off, the dual residual and |u| are measured in the range of F instead of mapping them back with F', which
+     * saves two applications of F' per regularizer. The two agree when F'F = I, but for other transforms (TV, TGV) they
+     * can change when ADMM stops and how ρ is balanced. */
+    std::vector<RegNorms> norms(R);
+    ForEachReg(regs, [&](Index const ir) {
       Vector zprev(z[ir].size());
       zprev.device(dev) = z[ir];
       // Note that in the Boyd primer relaxation is defined as ɑ * Ax - (1.f - ɑ) * (Bz - c) but this comes from the
       // constraint that Ax + Bz = c Our constraint is Fx = z, which defines A = F and B = -I, and hence the minus sign
       // becomes a plus in this line below, which matches the code examples on Boyd's website
+      auto &n = norms[ir];
       if (regs[ir].T) {
         Vector Fx(u[ir].size());
         regs[ir].T->forward(x, Fx);
@@ -99,12 +192,16 @@ auto ADMM::run(CMap const b) const -> Vector
         regs[ir].P->apply(1.f / ρ, u[ir], z[ir]);
         u[ir].device(dev) = u[ir] - z[ir];
         if (debug_z) { debug_z(io, ir, Fx, z[ir], u[ir]); }
-        float const nFx = ParallelNorm(Fx);
-        nz = ParallelNorm(z[ir]);
-        nu = ParallelNorm(regs[ir].T->adjoint(u[ir]));
-        nP = ParallelNorm(Fx - z[ir]);
-        nD = ParallelNorm(regs[ir].T->adjoint(z[ir] - zprev));
-        Log::Print("ADMM", "Reg {:02d} |Fx| {:3.2E} |z| {:3.2E} |F'u| {:3.2E}", ir, nFx, nz, nu);
+        n.Fx = ParallelNorm(Fx);
+        n.z = ParallelNorm(z[ir]);
+        n.P = ParallelNorm(Fx - z[ir]);
+        if (opts.exactResiduals) {
+          n.u = ParallelNorm(regs[ir].T->adjoint(u[ir]));
+          n.D = ParallelNorm(regs[ir].T->adjoint(z[ir] - zprev));
+        } else {
+          n.u = ParallelNorm(u[ir]);
+          n.D = ParallelNorm(z[ir] - zprev);
+        }
       } else {
         if (opts.ɑ > 0.f) {
           u[ir].device(dev) += opts.ɑ * x + (1.f - opts.ɑ) * zprev;
@@ -114,25 +211,41 @@ auto ADMM::run(CMap const b) const -> Vector
         regs[ir].P->apply(1.f / ρ, u[ir], z[ir]);
         u[ir].device(dev) = u[ir] - z[ir];
         if (debug_z) { debug_z(io, ir, x, z[ir], u[ir]); }
-        nz = ParallelNorm(z[ir]);
-        nu = ParallelNorm(u[ir]);
-        nP = ParallelNorm(x - z[ir]);
-        nD = ParallelNorm(z[ir] - zprev);
-        Log::Print("ADMM", "Reg {:02d} |z| {:3.2E} |F'u| {:3.2E}", ir, nz, nu);
+        n.Fx = normx;
+        n.z = ParallelNorm(z[ir]);
+        n.u = ParallelNorm(u[ir]);
+        n.P = ParallelNorm(x - z[ir]);
+        n.D = ParallelNorm(z[ir] - zprev);
+      }
+    });
+
+    float normFx = 0.f, normz = 0.f, normu = 0.f, pRes = 0.f, dRes = 0.f;
+    for (Index ir = 0; ir < R; ir++) {
+      auto const &n = norms[ir];
+      if (regs[ir].T) {
+        if (opts.exactResiduals) {
+          Log::Print("ADMM", "Reg {:02d} |Fx| {:3.2E} |z| {:3.2E} |F'u| {:3.2E}", ir, n.Fx, n.z, n.u);
+        } else {
+          Log::Print("ADMM", "Reg {:02d} |Fx| {:3.2E} |z| {:3.2E} |u| {:3.2E}", ir, n.Fx, n.z, n.u);
+        }
+      } else {
+        Log::Print("ADMM", "Reg {:02d} |z| {:3.2E} |u| {:3.2E}", ir, n.z, n.u);
       }
-      normz += nz * nz;
-      normu += nu * nu;
-      pRes += nP * nP;
-      dRes += nD * nD;
+      normFx += n.Fx * n.Fx;
+      normz += n.z * n.z;
+      normu += n.u * n.u;
+      pRes += n.P * n.P;
+      dRes += n.D * n.D;
     }
-    float const normx = ParallelNorm(x);
+    normFx = std::sqrt(normFx);
     normz = std::sqrt(normz);
     normu = std::sqrt(normu);
     pRes = std::sqrt(pRes) / std::max(normFx, normz);
     dRes = std::sqrt(dRes) / normu;
 
-    Log::Print("ADMM", "{:02d} |x| {:3.2E} |z| {:3.2E} |F'u| {:3.2E} ρ {:3.2E} |Pr| {:3.2E} |Du| {:3.2E}", io, normx, normz,
-               normu, ρ, pRes, dRes);
+    res = std::max(pRes, dRes);
+    Log::Print("ADMM", "{:02d} |x| {:3.2E} |z| {:3.2E} {} {:3.2E} ρ {:3.2E} |Pr| {:3.2E} |Du| {:3.2E}", io, normx, normz,
+               opts.exactResiduals ? "|F'u|" : "|u|", normu, ρ, pRes, dRes);
 
     if ((pRes < opts.ε) && (dRes < opts.ε)) {
       Log::Print("ADMM", "Primal and dual tolerances achieved, stopping");
@@ -154,6 +267,7 @@ auto ADMM::run(CMap const b) const -> Vector
         }
       }
     }
+    if (checkpoint) { checkpoint(io + 1, ρ, res, x, z, u); }
     if (Iterating::ShouldStop("ADMM")) { break; }
   }
   Iterating::Finished();
@@ -3,6 +3,8 @@
 #include "../op/ops.hpp"
 #include "regularizer.hpp"
 
+#include <optional>
+
 namespace rl {
 
 struct ADMM
@@ -13,6 +15,18 @@ struct ADMM
   using CMap = typename Op::CMap;
   using DebugX = std::function<void(Index const, Vector const &)>;
   using DebugZ = std::function<void(Index const, Index const, Vector const &, Vector const &, Vector const &)>;
+  using Checkpoint = std::function<void(
+    Index const, float const, float const, Vector const &, std::vector<Vector> const &, std::vector<Vector> const &)>;
+
+  // Everything needed to restart the outer loop exactly where it left off
+  struct State
+  {
+    Index               io; // Next outer iteration
+    float               ρ;
+    float               res; // Residual that sets the inexact inner tolerance
+    Vector              x;
+    std::vector<Vector> z, u;
+  };
 
   struct Opts
   {
@@ -32,6 +46,9 @@ struct ADMM
     float τmax;
 
     float ɑ = 0.f; // Over-relaxation parameter, set 1 < ɑ < 2
+
+    bool inexact = false;       // Tie the inner LSMR tolerance to the outer residuals, iters0 becomes the inner limit
+    bool exactResiduals = true; // Map the dual residual back through F', otherwise measure it in the range of F
   };
 
   Op::Ptr                  A;    // Forward model
@@ -40,9 +57,11 @@ struct ADMM
   Opts                     opts;
   DebugX                   debug_x = nullptr;
   DebugZ                   debug_z = nullptr;
+  Checkpoint               checkpoint = nullptr; // Called at the end of every outer iteration
+  std::optional<State>     resume = std::nullopt;
 
-  auto run(Vector const &b) const -> Vector;
-  auto run(CMap const b) const -> Vector;
+  auto run(Vector const &b, Vector const &x0 = Vector()) const -> Vector;
+  auto run(CMap const b, CMap x0 = CMap(nullptr, 0)) const -> Vector;
 };
 
 } // namespace rl
@@ -33,6 +33,13 @@ auto StableGivens(float const a, float const b) -> std::tuple<float, float, floa
   return std::make_tuple(c, s, ρ);
 }
 
+namespace {
+void Scale(Ops::Op<Cx>::Vector &x, float const s)
+{
+  Threads::ParallelMap(x.size(), [&x, s](Index const lo, Index const hi) { x.segment(lo, hi - lo) *= s; });
+}
+} // namespace
+
 auto Rotation(float const a, float const b) -> std::tuple<float, float, float>
 {
   float const ρ = std::hypot(a, b);
@@ -52,7 +59,7 @@ Bidiag::Bidiag(Ptr A_, Ptr Minv_, Ptr Ninv_, Vector &x, CMap &b, CMap &x0)
   if (Ninv) { Nv.resize(A->cols()); }
 
   if (x0.size()) {
-    x = x0;
+    x.device(Threads::CoreDevice()) = x0;
     A->forward(x, u); // Reuse u to save space
     if (Minv) {
       Mu.device(Threads::CoreDevice()) = b - u;
@@ -60,60 +67,58 @@ Bidiag::Bidiag(Ptr A_, Ptr Minv_, Ptr Ninv_, Vector &x, CMap &b, CMap &x0)
       u.device(Threads::CoreDevice()) = b - u;
     }
   } else {
-    x.setZero();
+    Threads::FirstTouch(x.data(), x.size());
     if (Minv) {
       Mu.device(Threads::CoreDevice()) = b;
     } else {
       u.device(Threads::CoreDevice()) = b;
     }
   }
+  /* u (and Mu) are kept unnormalized, i.e. scaled by β. The 1/β factor is folded into the scalings that already
+   * happen on the next pass, which saves a full read-write sweep over the (usually larger) range vector. */
   if (Minv) {
     Minv->forward(Mu, u);
     β = std::sqrt(CheckedDot(Mu, u));
-    Mu.device(Threads::CoreDevice()) = Mu * (1.f / β);
   } else {
     β = std::sqrt(CheckedDot(u, u));
   }
-  u.device(Threads::CoreDevice()) = u * (1.f / β);
   if (Ninv) {
     Nv = A->adjoint(u);
     Ninv->forward(Nv, v);
-    α = std::sqrt(CheckedDot(v, v));
-    Nv.device(Threads::CoreDevice()) = v * (1.f / α);
+    α = std::sqrt(CheckedDot(v, v)) / β;
+    Nv.device(Threads::CoreDevice()) = v * (1.f / (α * β));
   } else {
     A->adjoint(u, v);
-    α = std::sqrt(CheckedDot(v, v));
+    α = std::sqrt(CheckedDot(v, v)) / β;
   }
-  v.device(Threads::CoreDevice()) = v * (1.f / α);
+  Scale(v, 1.f / (α * β));
 }
 
 void Bidiag::next()
 {
   if (Minv) {
-    Mu.device(Threads::CoreDevice()) = -α * Mu;
+    Scale(Mu, -α / β);
     A->iforward(v, Mu);
     Minv->forward(Mu, u);
     β = std::sqrt(CheckedDot(Mu, u));
-    Mu.device(Threads::CoreDevice()) = Mu / β;
   } else {
-    u.device(Threads::CoreDevice()) = -α * u;
+    Scale(u, -α / β);
     A->iforward(v, u);
     β = std::sqrt(CheckedDot(u, u));
   }
-  u.device(Threads::CoreDevice()) = u * (1.f / β);
 
   if (Ninv) {
-    Nv.device(Threads::CoreDevice()) = -β * Nv;
+    Scale(Nv, -β * β);
     A->iadjoint(u, Nv);
     Ninv->forward(Nv, v);
-    α = std::sqrt(CheckedDot(Nv, v));
-    Nv.device(Threads::CoreDevice()) = Nv * (1.f / α);
+    α = std::sqrt(CheckedDot(Nv, v)) / β;
+    Scale(Nv, 1.f / (α * β));
   } else {
-    v.device(Threads::CoreDevice()) = -β * v;
+    Scale(v, -β * β);
     A->iadjoint(u, v);
-    α = std::sqrt(CheckedDot(v, v));
+    α = std::sqrt(CheckedDot(v, v)) / β;
   }
-  v.device(Threads::CoreDevice()) = v * (1.f / α);
+  Scale(v, 1.f / (α * β));
 }
 
 } // namespace rl
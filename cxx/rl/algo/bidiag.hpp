@@ -20,7 +20,7 @@ struct Bidiag
 
   std::shared_ptr<Op> A;
   std::shared_ptr<Op> Minv, Ninv;
-  Eigen::VectorXcf    u, Mu, v, Nv;
+  Eigen::VectorXcf    u, Mu, v, Nv; // u and Mu are stored scaled by β, v and Nv are normalized
   float               α;
   float               β;
 
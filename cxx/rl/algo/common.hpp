@@ -2,6 +2,7 @@
 
 #include "../log.hpp"
 #include "../tensors.hpp"
+#include "reduce.hpp"
 
 namespace rl {
 
@@ -10,6 +11,12 @@ template <typename Dims> void CheckDimsEqual(Dims const a, Dims const b)
   if (a != b) { throw Log::Failure("Algo", "Dimensions mismatch {} != {}", a, b); }
 }
 
+/* Contiguous single-precision complex vectors can use the compensated SIMD kernels, everything else (expressions,
+ * strided blocks, other scalar types) falls back to the pairwise Eigen reductions */
+template <typename Derived> constexpr bool UseCompensated =
+  std::is_same_v<typename Derived::Scalar, Cx> && bool(Derived::Flags & Eigen::DirectAccessBit) &&
+  Derived::InnerStrideAtCompileTime == 1;
+
 template <typename T> inline auto PairwiseDot(T const &x1, T const &x2, Index const st, Index const sz) -> typename T::Scalar
 {
   if (sz < 128) {
@@ -30,23 +37,25 @@ inline auto ParallelDot(Eigen::MatrixBase<Derived> const &x1, Eigen::MatrixBase<
   if (sz == 0) {
     return Scalar(0);
   } else {
-    Index const                   nT = Threads::GlobalThreadCount();
-    Index const                   den = sz / nT;
-    Index const                   rem = sz % nT;
-    Index const                   nC = std::min<Index>(sz, nT);
-    Eigen::Barrier                barrier(nC);
-    typename Derived::PlainObject partials(nC);
-    for (Index ic = 0; ic < nC; ic++) {
-      Index const lo = ic * den + std::min(ic, rem);
-      Index const hi = (ic + 1) * den + std::min(ic + 1, rem);
-      Index const n = hi - lo;
-      Threads::GlobalPool()->Schedule([&x1, &x2, &barrier, &partials, ic, lo, n] {
-        partials(ic) = PairwiseDot(x1, x2, lo, n);
-        barrier.Notify();
-      });
-    }
-    barrier.Wait();
-    return partials.sum();
+    // Accumulate the per-thread partials in double precision
+    using Acc = std::conditional_t<Eigen::NumTraits<Scalar>::IsComplex, std::complex<double>, double>;
+    Index const                       nT = Threads::GlobalThreadCount();
+    Index const                       den = sz / nT;
+    Index const                       rem = sz % nT;
+    Index const                       nC = std::min<Index>(sz, nT);
+    Eigen::Matrix<Acc, -1, 1>         partials(nC);
+    Threads::ParallelFor(nC, 1, [&](Index const clo, Index const chi) {
+      for (Index ic = clo; ic < chi; ic++) {
+        Index const lo = ic * den + std::min(ic, rem);
+        Index const hi = (ic + 1) * den + std::min(ic + 1, rem);
+        if constexpr (UseCompensated<Derived>) {
+          partials(ic) = CompensatedDot(x1.derived().data() + lo, x2.derived().data() + lo, hi - lo);
+        } else {
+          partials(ic) = static_cast<Acc>(PairwiseDot(x1, x2, lo, hi - lo));
+        }
+      }
+    });
+    return static_cast<Scalar>(partials.sum());
   }
 }
 
@@ -86,21 +95,20 @@ inline auto ParallelNorm(Eigen::MatrixBase<Derived> const &v) -> typename Eigen:
     Index const den = v.size() / nC;
     Index const rem = v.size() % nC;
 
-    typename Derived::PlainObject norms(nC);
-    Eigen::Barrier                barrier(nC);
-
-    for (Index ic = 0; ic < nC; ic++) {
-      Index const lo = ic * den + std::min(ic, rem);
-      Index const hi = (ic + 1) * den + std::min(ic + 1, rem);
-      Index const n = hi - lo;
-      Threads::GlobalPool()->Schedule([&v, &norms, &barrier, ic, lo, n] {
-        norms[ic] = v.segment(lo, n).norm();
-        barrier.Notify();
-      });
-    }
-    barrier.Wait();
+    Eigen::VectorXd norms2(nC); // Accumulate in double precision
+    Threads::ParallelFor(nC, 1, [&](Index const clo, Index const chi) {
+      for (Index ic = clo; ic < chi; ic++) {
+        Index const lo = ic * den + std::min(ic, rem);
+        Index const hi = (ic + 1) * den + std::min(ic + 1, rem);
+        if constexpr (UseCompensated<Derived>) {
+          norms2[ic] = CompensatedNorm2(v.derived().data() + lo, hi - lo);
+        } else {
+          norms2[ic] = v.segment(lo, hi - lo).squaredNorm();
+        }
+      }
+    });
 
-    return norms.norm();
+    return std::sqrt(norms2.sum());
   }
 }
 
@@ -17,6 +17,7 @@ template <typename S> Eig<S>::Eig(Eigen::Ref<Matrix const> const &g)
 }
 template struct Eig<float>;
 template struct Eig<Cx>;
+template struct Eig<Cxd>;
 
 template <typename S> SVD<S>::SVD(Eigen::Ref<Matrix const> const &mat)
 {
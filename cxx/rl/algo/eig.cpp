@@ -1,6 +1,9 @@
 #include "eig.hpp"
 
 #include "../algo/common.hpp"
+#include "bidiag.hpp"
+
+#include <Eigen/Eigenvalues>
 
 namespace rl {
 
@@ -52,4 +55,45 @@ auto PowerMethodAdjoint(std::shared_ptr<Ops::Op<Cx>> A, std::shared_ptr<Ops::Op<
   return {val, vec};
 }
 
+auto Lanczos(std::shared_ptr<Ops::Op<Cx>> A, std::shared_ptr<Ops::Op<Cx>> M, Index const iterLimit, float const tol)
+  -> LanczosReturn
+{
+  Log::Print("Lanczos", "{}", M ? "A'MA" : "A'A");
+  Eigen::VectorXcf  b = Eigen::VectorXcf::Random(A->rows());
+  Eigen::VectorXcf  x(A->cols());
+  Ops::Op<Cx>::CMap bm(b.data(), b.rows());
+  Ops::Op<Cx>::CMap x0(nullptr, 0);
+  Bidiag            bd(A, M, nullptr, x, bm, x0);
+  b.resize(0); // Only needed to start the recurrence
+  x.resize(0);
+
+  /* B'B = T is tridiagonal with diagonal α_i² + β_(i+1)² and off-diagonal α_(i+1)β_(i+1). The latter couples T to the
+   * next Lanczos vector, so |α_(k+1)β_(k+1) s_k| bounds the distance of a Ritz value to an eigenvalue. */
+  Eigen::VectorXd                                d(iterLimit), e(iterLimit);
+  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es;
+  LanczosReturn                                  ret{0.f, std::numeric_limits<float>::infinity(), 0};
+  double                                         α = bd.α;
+  for (Index ii = 0; ii < iterLimit; ii++) {
+    bd.next();
+    double const αn = std::isfinite(bd.α) ? bd.α : 0.; // Breakdown means the subspace is invariant
+    double const βn = bd.β;
+    d[ii] = α * α + βn * βn;
+    e[ii] = αn * βn;
+    double θ, s;
+    if (ii == 0) {
+      θ = d[0];
+      s = 1.;
+    } else {
+      es.computeFromTridiagonal(d.head(ii + 1), e.head(ii), Eigen::ComputeEigenvectors);
+      θ = es.eigenvalues()[ii];
+      s = es.eigenvectors()(ii, ii);
+    }
+    ret = {static_cast<float>(θ), static_cast<float>(std::abs(e[ii] * s)), ii + 1};
+    Log::Print("Lanczos", "{} Eigenvalue {} bound {}", ii, ret.val, ret.err);
+    if (ret.err <= tol * ret.val) { break; }
+    α = αn;
+  }
+  return ret;
+}
+
 } // namespace rl
@@ -16,4 +16,18 @@ auto PowerMethod(std::shared_ptr<Ops::Op<Cx>> A, Index const iterLimit) -> Power
 auto PowerMethodForward(std::shared_ptr<Ops::Op<Cx>> op, std::shared_ptr<Ops::Op<Cx>> M, Index const iterLimit) -> PowerReturn;
 auto PowerMethodAdjoint(std::shared_ptr<Ops::Op<Cx>> op, std::shared_ptr<Ops::Op<Cx>> M, Index const iterLimit) -> PowerReturn;
 
+struct LanczosReturn
+{
+  float val; // Largest Ritz value, a lower bound on the largest eigenvalue
+  float err; // Residual bound, the largest eigenvalue should lie in [val, val + err]
+  Index its;
+};
+
+/*
+ * Estimates the largest eigenvalue of A'MA (A'A if M is null) with Golub-Kahan bidiagonalization. The Ritz values
+ * converge to the extremal eigenvalues much faster than the power method, and the residual gives a stopping test.
+ */
+auto Lanczos(std::shared_ptr<Ops::Op<Cx>> A, std::shared_ptr<Ops::Op<Cx>> M, Index const iterLimit, float const tol = 1.e-3f)
+  -> LanczosReturn;
+
 } // namespace rl
@@ -0,0 +1,164 @@
+#include "fista.hpp"
+
+#include "../log.hpp"
+#include "common.hpp"
+#include "eig.hpp"
+#include "iter.hpp"
+
+namespace rl {
+
+namespace {
+using Op = FISTA::Op;
+using Vector = FISTA::Vector;
+using CMap = FISTA::CMap;
+
+auto Lipschitz(Op::Ptr const &A, Op::Ptr const &M, float const L) -> float
+{
+  if (L > 0.f) { return L; }
+  auto const  l = Lanczos(A, M, 32);
+  float const val = l.val + l.err; // The Ritz value is a lower bound, a step that is too long can diverge
+  Log::Print("PGD", "Lipschitz constant {:4.3E}", val);
+  return val;
+}
+
+// g = A'M(Ax - b)
+struct Gradient
+{
+  Op::Ptr A, M;
+  CMap    b;
+  Vector  r, Mr;
+
+  Gradient(Op::Ptr const &A_, Op::Ptr const &M_, CMap const &b_)
+    : A{A_}
+    , M{M_}
+    , b{b_}
+    , r(A->rows())
+    , Mr(M ? A->rows() : 0)
+  {
+    if (b.rows() != A->rows()) { throw Log::Failure("PGD", "b was size {} expected {}", b.rows(), A->rows()); }
+  }
+
+  void operator()(Vector const &x, Vector &g)
+  {
+    A->forward(x, r);
+    r.device(Threads::CoreDevice()) = r - b;
+    if (M) {
+      M->forward(r, Mr);
+      A->adjoint(Mr, g);
+    } else {
+      A->adjoint(r, g);
+    }
+  }
+};
+
+void Init(Vector &x, CMap const &x0)
+{
+  if (x0.size()) {
+    if (x0.rows() != x.rows()) { throw Log::Failure("PGD", "x0 was size {} expected {}", x0.rows(), x.rows()); }
+    x.device(Threads::CoreDevice()) = x0;
+  } else {
+    Threads::FirstTouch(x.data(), x.size());
+  }
+}
+} // namespace
+
+auto FISTA::run(Vector const &b, Vector const &x0) const -> Vector
+{
+  return run(CMap{b.data(), b.rows()}, CMap{x0.data(), x0.rows()});
+}
+
+auto FISTA::run(CMap const b, CMap x0) const -> Vector
+{
+  Index const n = A->cols();
+  auto const  dev = Threads::CoreDevice();
+  float const L = Lipschitz(A, M, opts.L);
+  Gradient    grad(A, M, b);
+  Vector      x(n), xold(n), y(n), g(n);
+  Init(x, x0);
+  y.device(dev) = x;
+
+  float t = 1.f;
+  Log::Print("FISTA", "IT |x|       |Δx|");
+  Iterating::Starting();
+  for (Index ii = 0; ii < opts.imax; ii++) {
+    grad(y, g);
+    g.device(dev) = y - g / L;
+    xold.swap(x);
+    P->apply(1.f / L, g, x);
+
+    // Re-use g and y for y - x and x - xold. Restart when the momentum opposes the prox-gradient step
+    g.device(dev) = y - x;
+    y.device(dev) = x - xold;
+    bool const  restart = opts.restart && std::real(ParallelDot(g, y)) > 0.f;
+    float const normx = ParallelNorm(x);
+    float const normΔ = ParallelNorm(y);
+    if (restart) {
+      t = 1.f;
+      y.device(dev) = x;
+    } else {
+      float const tnew = (1.f + std::sqrt(1.f + 4.f * t * t)) / 2.f;
+      y.device(dev) = x + ((t - 1.f) / tnew) * y;
+      t = tnew;
+    }
+    Log::Print("FISTA", "{:02d} {:4.3E} {:4.3E}{}", ii, normx, normΔ, restart ? " Restart" : "");
+    if (debug) { debug(ii, x); }
+    if (normΔ < opts.ε * normx) {
+      Log::Print("FISTA", "|Δx| below tolerance");
+      break;
+    }
+    if (Iterating::ShouldStop("FISTA")) { break; }
+  }
+  Iterating::Finished();
+  return x;
+}
+
+auto POGM::run(Vector const &b, Vector const &x0) const -> Vector
+{
+  return run(CMap{b.data(), b.rows()}, CMap{x0.data(), x0.rows()});
+}
+
+auto POGM::run(CMap const b, CMap x0) const -> Vector
+{
+  Index const n = A->cols();
+  auto const  dev = Threads::CoreDevice();
+  float const L = Lipschitz(A, M, opts.L);
+  Gradient    grad(A, M, b);
+  Vector      x(n), xold(n), w(n), wold(n), z(n), g(n);
+  Init(x, x0);
+  w.device(dev) = x;
+  z.device(dev) = x;
+
+  float θ = 1.f, γ = 1.f / L;
+  Log::Print("POGM", "IT |x|       |Δx|");
+  Iterating::Starting();
+  for (Index ii = 0; ii < opts.imax; ii++) {
+    grad(x, g);
+    wold.swap(w);
+    w.device(dev) = x - g / L;
+    float const θnew = (1.f + std::sqrt(1.f + (ii == opts.imax - 1 ? 8.f : 4.f) * θ * θ)) / 2.f;
+    float const a = (θ - 1.f) / θnew, c = θ / θnew, d = (θ - 1.f) / (L * γ * θnew);
+    z.device(dev) = w + a * (w - wold) + c * (w - x) + d * (z - x);
+    γ = (2.f * θ + θnew - 1.f) / (L * θnew);
+    xold.swap(x);
+    P->apply(γ, z, x);
+
+    // wold is free until the next swap, use it and g for the restart test
+    g.device(dev) = z - x;
+    wold.device(dev) = x - xold;
+    bool const  restart = opts.restart && std::real(ParallelDot(g, wold)) > 0.f;
+    float const normx = ParallelNorm(x);
+    float const normΔ = ParallelNorm(wold);
+    θ = restart ? 1.f : θnew;
+    Log::Print("POGM", "{:02d} {:4.3E} {:4.3E}{}", ii, normx, normΔ, restart ? " Restart" : "");
+    if (debug) { debug(ii, x); }
+    if (normΔ < opts.ε * normx) {
+      Log::Print("POGM", "|Δx| below tolerance");
+      break;
+    }
+    if (Iterating::ShouldStop("POGM")) { break; }
+  }
+  Iterating::Finished();
+  return x;
+}
+
+} // namespace rl
@@ -7,6 +7,25 @@
 
 namespace rl {
 
+namespace {
+/*
+ * Complex vector stored as interleaved bfloat16 pairs. All the updates use real coefficients, so they are applied
+ * elementwise to the interleaved real and imaginary parts, widening to fp32 in registers without temporaries.
+ */
+struct HalfVector
+{
+  Eigen::Array<Eigen::bfloat16, Eigen::Dynamic, 1> d;
+
+  HalfVector(Index const n)
+    : d(2 * n)
+  {
+  }
+};
+
+auto Floats(Cx *x) -> float * { return reinterpret_cast<float *>(x); }
+auto Floats(Cx const *x) -> float const * { return reinterpret_cast<float const *>(x); }
+} // namespace
+
 auto LSMR::run(Vector const &b, Vector const &x0) const -> Vector
 {
   return run(CMap{b.data(), b.rows()}, CMap{x0.data(), x0.rows()});
@@ -22,10 +41,26 @@ auto LSMR::run(CMap const b, CMap x0) const -> Vector
   Index const cols = A->cols();
   if (rows < 1 || cols < 1) { throw Log::Failure("LSMR", "Invalid operator size rows {} cols {}", rows, cols); }
   if (b.rows() != rows) { throw Log::Failure("LSMR", "b had size {} expected {}", b.rows(), rows); }
-  Vector h(cols), h̅(cols), x(cols);
+  Vector x(cols);
   Bidiag bd(A, Minv, Ninv, x, b, x0);
-  h = bd.v;
-  h̅.setZero();
+  // The search directions are only ever streamed, so they can be held in reduced precision. x stays in fp32.
+  Vector     h, h̅;
+  HalfVector hq(opts.bf16 ? cols : 0), h̅q(opts.bf16 ? cols : 0);
+  if (opts.bf16) {
+    Log::Print("LSMR", "Storing search directions as bfloat16");
+    float const *v = Floats(bd.v.data());
+    Threads::ParallelMap(2 * cols, [&](Index const lo, Index const hi) {
+      for (Index ii = lo; ii < hi; ii++) {
+        hq.d[ii] = Eigen::bfloat16(v[ii]);
+        h̅q.d[ii] = Eigen::bfloat16(0.f);
+      }
+    });
+  } else {
+    h.resize(cols);
+    h̅.resize(cols);
+    h.device(Threads::CoreDevice()) = bd.v;
+    Threads::FirstTouch(h̅.data(), h̅.size());
+  }
 
   // Initialize transformation variables. There are a lot
   float ζ̅ = bd.α * bd.β;
@@ -77,10 +112,29 @@ auto LSMR::run(CMap const b, CMap x0) const -> Vector
     ζ = c̅ * ζ̅;
     ζ̅ = -s̅ * ζ̅;
 
-    // Update h, h̅, x.
-    h̅.device(Threads::CoreDevice()) = h - (θ̅ * ρ / (ρold * ρ̅old)) * h̅;
-    x.device(Threads::CoreDevice()) = x + (ζ / (ρ * ρ̅)) * h̅;
-    h.device(Threads::CoreDevice()) = bd.v - (θnew / ρ) * h;
+    // Update h̅, x, h in a single pass so each vector is only streamed once
+    float const sh̅ = θ̅ * ρ / (ρold * ρ̅old), sx = ζ / (ρ * ρ̅), sh = θnew / ρ;
+    if (opts.bf16) {
+      float       *xf = Floats(x.data());
+      float const *v = Floats(bd.v.data());
+      Threads::ParallelMap(2 * x.size(), [&](Index const lo, Index const hi) {
+        for (Index ij = lo; ij < hi; ij++) {
+          float const hf = static_cast<float>(hq.d[ij]);
+          float const h̅f = hf - sh̅ * static_cast<float>(h̅q.d[ij]);
+          xf[ij] += sx * h̅f;
+          hq.d[ij] = Eigen::bfloat16(v[ij] - sh * hf);
+          h̅q.d[ij] = Eigen::bfloat16(h̅f);
+        }
+      });
+    } else {
+      Threads::ParallelMap(x.size(), [&](Index const lo, Index const hi) {
+        auto hs = h.segment(lo, hi - lo);
+        auto h̅s = h̅.segment(lo, hi - lo);
+        h̅s = hs - sh̅ * h̅s;
+        x.segment(lo, hi - lo) += sx * h̅s;
+        hs = bd.v.segment(lo, hi - lo) - sh * hs;
+      });
+    }
 
     // Estimate of |r|.
     float const β́ = ĉ * β̈;
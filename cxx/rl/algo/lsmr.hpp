@@ -26,6 +26,7 @@ struct LSMR
     float bTol = 1.e-6f;
     float cTol = 1.e-6f;
     float λ = 0.f;
+    bool  bf16 = false; // Store the search directions as bfloat16
   };
 
   Op::Ptr A;
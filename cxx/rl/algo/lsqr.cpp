@@ -33,6 +33,12 @@ auto LSQR::run(CMap const b, float const λ, CMap const x0) const -> Vector
   float cs2 = -1.f;
   float sn2 = 0.f;
 
+  // Fixed chunking so the fused |w|² reduction is deterministic
+  Index const nC = std::min<Index>(cols, Threads::GlobalThreadCount());
+  Index const den = cols / nC;
+  Index const rem = cols % nC;
+  Eigen::ArrayXf wn2(nC);
+
   Log::Print("LSQR", "IT |x|       |r|       |A'r|     |A|       cond(A)");
   Log::Print("LSQR", "{:02d} {:4.3E} {:4.3E} {:4.3E}", 0, ParallelNorm(x), bd.β, std::fabs(bd.α * bd.β));
   Iterating::Starting();
@@ -55,8 +61,18 @@ auto LSQR::run(CMap const b, float const λ, CMap const x0) const -> Vector
     float const τ = s * ɸ;
     float const θ = s * bd.α;
     ρ̅ = -c * bd.α;
-    x = x + w * (ɸ / ρ);
-    w = bd.v - w * (θ / ρ);
+    // Update x and w in one pass, accumulating |w|² for the cond(A) estimate
+    float const sx = ɸ / ρ, sw = θ / ρ;
+    Threads::ParallelFor(nC, 1, [&](Index const clo, Index const chi) {
+      for (Index ic = clo; ic < chi; ic++) {
+        Index const lo = ic * den + std::min(ic, rem);
+        Index const hi = (ic + 1) * den + std::min(ic + 1, rem);
+        auto        ws = w.segment(lo, hi - lo);
+        x.segment(lo, hi - lo) += sx * ws;
+        ws = bd.v.segment(lo, hi - lo) - sw * ws;
+        wn2[ic] = ws.squaredNorm();
+      }
+    });
 
     // Estimate norms
     float const δ = sn2 * ρ;
@@ -68,7 +84,7 @@ auto LSQR::run(CMap const b, float const λ, CMap const x0) const -> Vector
     std::tie(cs2, sn2, ɣ) = StableGivens(ɣ̅, θ);
     z = rhs / ɣ;
     xxnorm += z * z;
-    ddnorm = ddnorm + std::pow(ParallelNorm(w), 2) / (ρ * ρ);
+    ddnorm = ddnorm + wn2.sum() / (ρ * ρ);
 
     normA = std::sqrt(normA * normA + bd.α * bd.α + bd.β * bd.β + λ * λ);
     float const condA = normA * std::sqrt(ddnorm);
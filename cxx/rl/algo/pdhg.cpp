@@ -1,90 +1,143 @@
 #include "pdhg.hpp"
 
 #include "../log.hpp"
-#include "../prox/lsq.hpp"
-#include "../prox/stack.hpp"
-#include "../tensors.hpp"
 #include "common.hpp"
 #include "eig.hpp"
+#include "iter.hpp"
 
 namespace rl {
 
-PDHG::PDHG(std::shared_ptr<Op>             A,
-           std::shared_ptr<Op>             P,
-           std::vector<Regularizer> const &regs,
-           std::vector<float> const       &σin,
-           float const                     τin,
-           Callback const                 &cb)
+PDHG::PDHG(Op::Ptr A_, Op::Ptr P, std::vector<Regularizer> const &regs_, Opts const &opts_, DebugX debug_)
+  : A{A_}
+  , regs{regs_}
+  , opts{opts_}
+  , debug{debug_}
 {
   Index const          nR = regs.size();
   std::vector<Op::Ptr> ops(nR);
-  std::transform(regs.begin(), regs.end(), ops.begin(), [](auto R) { return R.T; });
-  Aʹ = std::make_shared<Ops::VStack<Cx>>(A, ops);
-  l2 = std::make_shared<Proxs::LeastSquares<Cx>>(1.f, A->rows());
-  std::vector<std::shared_ptr<Prox>> ps;
-  ps.push_back(l2);
-  for (Index ii = 0; ii < nR; ii++) {
-    ps.push_back(std::make_shared<Proxs::ConjugateProx<Cx>>(regs[ii].P));
-  }
-  proxʹ = std::make_shared<Proxs::StackProx<Cx>>(ps);
+  std::transform(regs.begin(), regs.end(), ops.begin(), [&](auto const &R) {
+    return R.T ? R.T : std::static_pointer_cast<Op>(std::make_shared<Ops::Identity<Cx>>(A->cols()));
+  });
+  K = nR ? std::static_pointer_cast<Op>(std::make_shared<Ops::VStack<Cx>>(A, ops)) : A;
 
-  if (σin.size() == regs.size()) {
-    σ = σin;
+  if (static_cast<Index>(opts.σ.size()) == nR) {
+    σ = opts.σ;
   } else {
     σ.clear();
-    for (auto &G : ops) {
-      auto eigG = PowerMethod(G, 32);
-      σ.push_back(1.f / eigG.val);
+    for (auto const &T : ops) {
+      auto const l = Lanczos(T, nullptr, 32);
+      σ.push_back(1.f / (l.val + l.err));
     }
   }
 
-  std::vector<std::shared_ptr<Op>> sG;
-  sG.push_back(P);
-  for (Index ii = 0; ii < nR; ii++) {
-    sG.push_back(std::make_shared<Ops::DiagScale<Cx>>(regs[ii].T->rows(), σ[ii]));
+  std::vector<Op::Ptr> sG;
+  sG.push_back(P ? P : std::static_pointer_cast<Op>(std::make_shared<Ops::Identity<Cx>>(A->rows())));
+  for (Index ir = 0; ir < nR; ir++) {
+    sG.push_back(std::make_shared<Ops::DiagScale<Cx>>(ops[ir]->rows(), σ[ir]));
   }
-  σOp = std::make_shared<Ops::DStack<Cx>>(sG);
+  auto const σOp = std::make_shared<Ops::DStack<Cx>>(sG);
+  σd = σOp->forward(Vector::Ones(K->rows()));
 
-  if (τin < 0.f) {
-    auto eig = PowerMethodForward(Aʹ, σOp, 32);
-    τ = 1.f / eig.val;
+  if (opts.τ > 0.f) {
+    τ = opts.τ;
   } else {
-    τ = τin;
+    auto const l = Lanczos(K, σOp, 32);
+    τ = 1.f / (l.val + l.err);
   }
+  Log::Print("PDHG", "σ {:4.3E} τ {:4.3E}", fmt::join(σ, ","), τ);
+}
 
-  u.resize(Aʹ->rows());
-  u.setZero();
-  v.resize(Aʹ->rows());
-  v.setZero();
+auto PDHG::run(Vector const &b, Vector const &x0) const -> Vector
+{
+  return run(CMap{b.data(), b.rows()}, CMap{x0.data(), x0.rows()});
+}
 
-  x.resize(Aʹ->cols());
-  x.setZero();
-  x̅.resize(Aʹ->cols());
-  x̅.setZero();
-  xold.resize(Aʹ->cols());
-  xold.setZero();
-  xdiff.resize(Aʹ->cols());
-  xdiff.setZero();
+auto PDHG::run(CMap const b, CMap x0) const -> Vector
+{
+  Index const nA = A->rows();
+  if (b.rows() != nA) { throw Log::Failure("PDHG", "b was size {} expected {}", b.rows(), nA); }
+  auto const dev = Threads::CoreDevice();
 
-  debug = cb;
+  /* K x and K'u are carried between iterations, so each iteration costs one forward and one adjoint application and the
+   * residuals come for free. K x̅ = 2 K x - K xold by linearity.
+   */
+  Vector x(K->cols()), KTu(K->cols());
+  Vector u(K->rows()), uold(K->rows()), Kx(K->rows()), Kxold(K->rows()), r(K->rows());
+  Threads::FirstTouch(u.data(), u.size());
+  Threads::FirstTouch(KTu.data(), KTu.size());
+  if (x0.size()) {
+    if (x0.rows() != K->cols()) { throw Log::Failure("PDHG", "x0 was size {} expected {}", x0.rows(), K->cols()); }
+    x.device(dev) = x0;
+    K->forward(x, Kx);
+  } else {
+    Threads::FirstTouch(x.data(), x.size());
+    Threads::FirstTouch(Kx.data(), Kx.size());
+  }
 
-  Log::Print("PDHG", "σ {:4.3E} τ {:4.3E}", fmt::join(σ, ","), τ);
-}
+  float τk = τ, γ = 1.f, ɑ = 0.5f; // γ scales the dual steps, τk γ = τ is held constant
+  float p1 = 0.f, d1 = 0.f;
+  Log::Print("PDHG", "IT |x|       |p|       |d|       τ");
+  Iterating::Starting();
+  for (Index ii = 0; ii < opts.imax; ii++) {
+    x.device(dev) = x - τk * KTu;
+    Kxold.swap(Kx);
+    K->forward(x, Kx);
 
-auto PDHG::run(Cx const *bdata, Index const iterLimit) -> Vector
-{
-  l2->setBias(bdata);
-  for (Index ii = 0; ii < iterLimit; ii++) {
-    xold = x;
-    v = u + σOp->forward(Aʹ->forward(x̅));
-    proxʹ->apply(σOp, v, u);
-    x = x - τ * Aʹ->adjoint(u);
-    xdiff = x - xold;
-    x̅ = x + xdiff;
-    float const normr = ParallelNorm(xdiff) / std::sqrt(τ);
-    Log::Print("PDHG", "{:02d}: |x| {:4.3E} |r| {:4.3E}", ii, ParallelNorm(x), normr);
-    if (debug) { debug(ii, x, x̅, xdiff); }
+    // Dual ascent step plus the prox of the data term's conjugate, (v - σb) / (1 + σ), in one pass
+    uold.swap(u);
+    Threads::ParallelMap(K->rows(), [&](Index const lo, Index const hi) {
+      Index const n = hi - lo;
+      u.segment(lo, n) =
+        uold.segment(lo, n) + γ * σd.segment(lo, n).cwiseProduct(2.f * Kx.segment(lo, n) - Kxold.segment(lo, n));
+      if (lo < nA) {
+        Index const m = std::min(hi, nA) - lo;
+        Vector const σs = γ * σd.segment(lo, m);
+        u.segment(lo, m) = (u.segment(lo, m) - σs.cwiseProduct(b.segment(lo, m))).cwiseQuotient(Vector::Ones(m) + σs);
+      }
+    });
+    // Regularizers via Moreau, prox_σg*(v) = v - σ prox_g/σ(v/σ)
+    Index start = nA;
+    for (size_t ir = 0; ir < regs.size(); ir++) {
+      Index const sz = regs[ir].T ? regs[ir].T->rows() : A->cols();
+      float const s = γ * σ[ir];
+      Vector      v = u.segment(start, sz) / s;
+      Vector      z(sz);
+      regs[ir].P->apply(1.f / s, v, z);
+      u.segment(start, sz).device(dev) = u.segment(start, sz) - s * z;
+      start += sz;
+    }
+    K->adjoint(u, KTu);
+
+    /* Primal residual is K'u, the dual residual is Σ⁻¹(uold - u) + K(x - xold). Rows with a zero dual step (zero
+     * pre-conditioner weights) never change u, so they contribute nothing to the first term instead of 0/0. */
+    r.device(dev) =
+      (σd.real().array() > 0.f).select((uold - u).array() / (γ * σd.array()), Cx(0.f)).matrix() + Kx - Kxold;
+    float const normp = ParallelNorm(KTu);
+    float const normd = ParallelNorm(r);
+    Log::Print("PDHG", "{:02d} {:4.3E} {:4.3E} {:4.3E} {:4.3E}", ii, ParallelNorm(x), normp, normd, τk);
+    if (debug) { debug(ii, x); }
+    if (ii == 0) {
+      p1 = normp;
+      d1 = normd;
+    } else if (normp < opts.ε * p1 && normd < opts.ε * d1) {
+      Log::Print("PDHG", "Residuals below tolerance");
+      break;
+    }
+    if (opts.balance) {
+      float constexpr Δ = 1.5f, η = 0.95f;
+      if (normp > Δ * normd) {
+        τk /= (1.f - ɑ);
+        γ *= (1.f - ɑ);
+        ɑ *= η;
+      } else if (normp < normd / Δ) {
+        τk *= (1.f - ɑ);
+        γ /= (1.f - ɑ);
+        ɑ *= η;
+      }
+    }
+    if (Iterating::ShouldStop("PDHG")) { break; }
   }
+  Iterating::Finished();
   return x;
 }
 
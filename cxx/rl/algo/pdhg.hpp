@@ -1,41 +1,48 @@
 #pragma once
 
 #include "../op/ops.hpp"
-#include "../prox/lsq.hpp"
-#include "../prox/prox.hpp"
-#include "../prox/stack.hpp"
 #include "regularizer.hpp"
 
 namespace rl {
 
+/*
+ * Primal-Dual Hybrid Gradient for min ½|Ax - b|² + Σ g_i(T_i x)
+ *
+ * The dual step for the data term is diagonally pre-conditioned by P (Pock & Chambolle 2011), the regularizer dual steps
+ * are 1/|T_i|². The primal step τ is 1/|K'ΣK| with K = [A; T_1; ...]. The operator norms only depend on the trajectory and
+ * regularizers, so they can be computed once (see recon-pdhg-setup) and passed back in. Optionally the primal and dual
+ * steps are re-balanced from the residuals each iteration (Goldstein et al. 2015), keeping τσ fixed.
+ */
 struct PDHG
 {
   using Op = Ops::Op<Cx>;
-  using Prox = Proxs::Prox<Cx>;
-  using Scalar = typename Op::Scalar;
   using Vector = typename Op::Vector;
   using CMap = typename Op::CMap;
-  using Callback = std::function<void(Index const, Vector const &, Vector const &, Vector const &)>;
+  using DebugX = std::function<void(Index const, Vector const &)>;
 
-  PDHG(std::shared_ptr<Op>             A,
-       std::shared_ptr<Op>             P,
-       std::vector<Regularizer> const &regs,
-       std::vector<float> const       &σ = std::vector<float>(),
-       float const                     τ = -1.f,
-       Callback const                 &cb = nullptr);
+  struct Opts
+  {
+    Index              imax = 64;
+    float              ε = 1.e-3f;     // Stop when both residuals drop below ε times their initial value
+    bool               balance = true; // Adaptive step balancing
+    float              τ = -1.f;       // Primal step, calculated if negative
+    std::vector<float> σ;              // Regularizer dual steps, calculated if empty
+  };
 
-  auto run(Cx const *bdata, Index const iterLimit) -> Vector;
+  PDHG(Op::Ptr A, Op::Ptr P, std::vector<Regularizer> const &regs, Opts const &opts, DebugX debug = nullptr);
+
+  auto run(Vector const &b, Vector const &x0 = Vector()) const -> Vector;
+  auto run(CMap const b, CMap x0 = CMap(nullptr, 0)) const -> Vector;
 
   std::vector<float> σ;
   float              τ;
 
 private:
-  std::shared_ptr<Op>                      Aʹ;
-  std::shared_ptr<Proxs::LeastSquares<Cx>> l2;
-  std::shared_ptr<Proxs::StackProx<Cx>>    proxʹ;
-  std::shared_ptr<Ops::Op<Cx>>             σOp;
-  Vector                                   x, x̅, xold, xdiff, u, v;
-  Callback                                 debug = nullptr;
+  Op::Ptr                  A, K;
+  std::vector<Regularizer> regs;
+  Opts                     opts;
+  Vector                   σd; // Diagonal dual step for every row of K
+  DebugX                   debug;
 };
 
 } // namespace rl
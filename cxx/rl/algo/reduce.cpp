@@ -0,0 +1,274 @@
+#include "reduce.hpp"
+
+/* This file must not be compiled with -ffast-math, which allows the compiler to cancel the Kahan compensation terms.
+ * The SIMD kernels are compiled for their instruction set with target attributes and chosen at runtime, so the library
+ * does not need to be built for a particular CPU. */
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define RL_X86_KERNELS
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define RL_NEON_KERNELS
+#include <arm_neon.h>
+#endif
+
+namespace rl {
+
+namespace {
+struct Kahan
+{
+  double s = 0., c = 0.;
+
+  void add(double const p)
+  {
+    double const y = p - c;
+    double const t = s + y;
+    c = (t - s) - y;
+    s = t;
+  }
+
+  auto sum() const -> double { return s - c; }
+};
+
+auto DotScalar(Cx const *a, Cx const *b, Index const n) -> std::complex<double>
+{
+  Kahan re, im;
+  for (Index ii = 0; ii < n; ii++) {
+    double const ar = a[ii].real(), ai = a[ii].imag(), br = b[ii].real(), bi = b[ii].imag();
+    re.add(ar * br);
+    re.add(ai * bi);
+    im.add(ar * bi);
+    im.add(-ai * br);
+  }
+  return {re.sum(), im.sum()};
+}
+
+auto Norm2Scalar(Cx const *a, Index const n) -> double
+{
+  Kahan s;
+  for (Index ii = 0; ii < n; ii++) {
+    double const ar = a[ii].real(), ai = a[ii].imag();
+    s.add(ar * ar);
+    s.add(ai * ai);
+  }
+  return s.sum();
+}
+
+#if defined(RL_X86_KERNELS)
+__attribute__((target("avx2"))) inline void KahanAdd(__m256d &s, __m256d &c, __m256d const p)
+{
+  __m256d const y = _mm256_sub_pd(p, c);
+  __m256d const t = _mm256_add_pd(s, y);
+  c = _mm256_sub_pd(_mm256_sub_pd(t, s), y);
+  s = t;
+}
+
+__attribute__((target("avx2"))) inline auto Sum(__m256d const s, __m256d const c) -> double
+{
+  alignas(32) double v[4];
+  _mm256_store_pd(v, _mm256_sub_pd(s, c));
+  return (v[0] + v[1]) + (v[2] + v[3]);
+}
+
+// Four complex numbers per iteration, split into two halves that are widened to double
+__attribute__((target("avx2"))) auto DotAVX2(Cx const *a, Cx const *b, Index const n) -> std::complex<double>
+{
+  auto const    pa = reinterpret_cast<float const *>(a);
+  auto const    pb = reinterpret_cast<float const *>(b);
+  __m256d const sign = _mm256_setr_pd(1., -1., 1., -1.);
+  __m256d       sr0 = _mm256_setzero_pd(), cr0 = sr0, sr1 = sr0, cr1 = sr0, si0 = sr0, ci0 = sr0, si1 = sr0, ci1 = sr0;
+  Index const   nV = n - n % 4;
+  for (Index ii = 0; ii < nV; ii += 4) {
+    __m256 const  fa = _mm256_loadu_ps(pa + 2 * ii);
+    __m256 const  fb = _mm256_loadu_ps(pb + 2 * ii);
+    __m256d const a0 = _mm256_cvtps_pd(_mm256_castps256_ps128(fa));
+    __m256d const a1 = _mm256_cvtps_pd(_mm256_extractf128_ps(fa, 1));
+    __m256d const b0 = _mm256_cvtps_pd(_mm256_castps256_ps128(fb));
+    __m256d const b1 = _mm256_cvtps_pd(_mm256_extractf128_ps(fb, 1));
+    KahanAdd(sr0, cr0, _mm256_mul_pd(a0, b0)); // ar·br, ai·bi
+    KahanAdd(sr1, cr1, _mm256_mul_pd(a1, b1));
+    KahanAdd(si0, ci0, _mm256_mul_pd(a0, _mm256_mul_pd(_mm256_permute_pd(b0, 0b0101), sign))); // ar·bi, -ai·br
+    KahanAdd(si1, ci1, _mm256_mul_pd(a1, _mm256_mul_pd(_mm256_permute_pd(b1, 0b0101), sign)));
+  }
+  auto const tail = DotScalar(a + nV, b + nV, n - nV);
+  return {Sum(sr0, cr0) + Sum(sr1, cr1) + tail.real(), Sum(si0, ci0) + Sum(si1, ci1) + tail.imag()};
+}
+
+__attribute__((target("avx2"))) auto Norm2AVX2(Cx const *a, Index const n) -> double
+{
+  auto const  pa = reinterpret_cast<float const *>(a);
+  __m256d     s0 = _mm256_setzero_pd(), c0 = s0, s1 = s0, c1 = s0;
+  Index const nV = n - n % 4;
+  for (Index ii = 0; ii < nV; ii += 4) {
+    __m256 const  fa = _mm256_loadu_ps(pa + 2 * ii);
+    __m256d const a0 = _mm256_cvtps_pd(_mm256_castps256_ps128(fa));
+    __m256d const a1 = _mm256_cvtps_pd(_mm256_extractf128_ps(fa, 1));
+    KahanAdd(s0, c0, _mm256_mul_pd(a0, a0));
+    KahanAdd(s1, c1, _mm256_mul_pd(a1, a1));
+  }
+  return Sum(s0, c0) + Sum(s1, c1) + Norm2Scalar(a + nV, n - nV);
+}
+
+__attribute__((target("avx512f"))) inline void KahanAdd(__m512d &s, __m512d &c, __m512d const p)
+{
+  __m512d const y = _mm512_sub_pd(p, c);
+  __m512d const t = _mm512_add_pd(s, y);
+  c = _mm512_sub_pd(_mm512_sub_pd(t, s), y);
+  s = t;
+}
+
+__attribute__((target("avx512f"))) inline auto Sum(__m512d const s, __m512d const c) -> double
+{
+  return _mm512_reduce_add_pd(_mm512_sub_pd(s, c));
+}
+
+// Widen the low (H = 0) or high (H = 1) eight floats to double
+template <int H> __attribute__((target("avx512f"))) inline auto Widen(__m512 const f) -> __m512d
+{
+  return _mm512_cvtps_pd(_mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(f), H)));
+}
+
+// Eight complex numbers per iteration
+__attribute__((target("avx512f"))) auto DotAVX512(Cx const *a, Cx const *b, Index const n) -> std::complex<double>
+{
+  auto const    pa = reinterpret_cast<float const *>(a);
+  auto const    pb = reinterpret_cast<float const *>(b);
+  __m512d const sign = _mm512_setr_pd(1., -1., 1., -1., 1., -1., 1., -1.);
+  __m512d       sr0 = _mm512_setzero_pd(), cr0 = sr0, sr1 = sr0, cr1 = sr0, si0 = sr0, ci0 = sr0, si1 = sr0, ci1 = sr0;
+  Index const   nV = n - n % 8;
+  for (Index ii = 0; ii < nV; ii += 8) {
+    __m512 const  fa = _mm512_loadu_ps(pa + 2 * ii);
+    __m512 const  fb = _mm512_loadu_ps(pb + 2 * ii);
+    __m512d const a0 = Widen<0>(fa), a1 = Widen<1>(fa), b0 = Widen<0>(fb), b1 = Widen<1>(fb);
+    KahanAdd(sr0, cr0, _mm512_mul_pd(a0, b0));
+    KahanAdd(sr1, cr1, _mm512_mul_pd(a1, b1));
+    KahanAdd(si0, ci0, _mm512_mul_pd(a0, _mm512_mul_pd(_mm512_permute_pd(b0, 0x55), sign)));
+    KahanAdd(si1, ci1, _mm512_mul_pd(a1, _mm512_mul_pd(_mm512_permute_pd(b1, 0x55), sign)));
+  }
+  auto const tail = DotScalar(a + nV, b + nV, n - nV);
+  return {Sum(sr0, cr0) + Sum(sr1, cr1) + tail.real(), Sum(si0, ci0) + Sum(si1, ci1) + tail.imag()};
+}
+
+__attribute__((target("avx512f"))) auto Norm2AVX512(Cx const *a, Index const n) -> double
+{
+  auto const  pa = reinterpret_cast<float const *>(a);
+  __m512d     s0 = _mm512_setzero_pd(), c0 = s0, s1 = s0, c1 = s0;
+  Index const nV = n - n % 8;
+  for (Index ii = 0; ii < nV; ii += 8) {
+    __m512 const  fa = _mm512_loadu_ps(pa + 2 * ii);
+    __m512d const a0 = Widen<0>(fa), a1 = Widen<1>(fa);
+    KahanAdd(s0, c0, _mm512_mul_pd(a0, a0));
+    KahanAdd(s1, c1, _mm512_mul_pd(a1, a1));
+  }
+  return Sum(s0, c0) + Sum(s1, c1) + Norm2Scalar(a + nV, n - nV);
+}
+#endif
+
+#if defined(RL_NEON_KERNELS)
+inline void KahanAdd(float64x2_t &s, float64x2_t &c, float64x2_t const p)
+{
+  float64x2_t const y = vsubq_f64(p, c);
+  float64x2_t const t = vaddq_f64(s, y);
+  c = vsubq_f64(vsubq_f64(t, s), y);
+  s = t;
+}
+
+inline auto Sum(float64x2_t const s, float64x2_t const c) -> double { return vaddvq_f64(vsubq_f64(s, c)); }
+
+// Two complex numbers per iteration, one in each half
+auto DotNEON(Cx const *a, Cx const *b, Index const n) -> std::complex<double>
+{
+  auto const        pa = reinterpret_cast<float const *>(a);
+  auto const        pb = reinterpret_cast<float const *>(b);
+  float64x2_t const sign = {1., -1.};
+  float64x2_t       sr0 = vdupq_n_f64(0.), cr0 = sr0, sr1 = sr0, cr1 = sr0, si0 = sr0, ci0 = sr0, si1 = sr0, ci1 = sr0;
+  Index const       nV = n - n % 2;
+  for (Index ii = 0; ii < nV; ii += 2) {
+    float32x4_t const fa = vld1q_f32(pa + 2 * ii);
+    float32x4_t const fb = vld1q_f32(pb + 2 * ii);
+    float64x2_t const a0 = vcvt_f64_f32(vget_low_f32(fa)), a1 = vcvt_high_f64_f32(fa);
+    float64x2_t const b0 = vcvt_f64_f32(vget_low_f32(fb)), b1 = vcvt_high_f64_f32(fb);
+    KahanAdd(sr0, cr0, vmulq_f64(a0, b0));
+    KahanAdd(sr1, cr1, vmulq_f64(a1, b1));
+    KahanAdd(si0, ci0, vmulq_f64(a0, vmulq_f64(vextq_f64(b0, b0, 1), sign)));
+    KahanAdd(si1, ci1, vmulq_f64(a1, vmulq_f64(vextq_f64(b1, b1, 1), sign)));
+  }
+  auto const tail = DotScalar(a + nV, b + nV, n - nV);
+  return {Sum(sr0, cr0) + Sum(sr1, cr1) + tail.real(), Sum(si0, ci0) + Sum(si1, ci1) + tail.imag()};
+}
+
+auto Norm2NEON(Cx const *a, Index const n) -> double
+{
+  auto const  pa = reinterpret_cast<float const *>(a);
+  float64x2_t s0 = vdupq_n_f64(0.), c0 = s0, s1 = s0, c1 = s0;
+  Index const nV = n - n % 2;
+  for (Index ii = 0; ii < nV; ii += 2) {
+    float32x4_t const fa = vld1q_f32(pa + 2 * ii);
+    float64x2_t const a0 = vcvt_f64_f32(vget_low_f32(fa)), a1 = vcvt_high_f64_f32(fa);
+    KahanAdd(s0, c0, vmulq_f64(a0, a0));
+    KahanAdd(s1, c1, vmulq_f64(a1, a1));
+  }
+  return Sum(s0, c0) + Sum(s1, c1) + Norm2Scalar(a + nV, n - nV);
+}
+#endif
+
+enum struct ISA
+{
+  Scalar,
+  NEON,
+  AVX2,
+  AVX512
+};
+
+auto Chosen() -> ISA
+{
+  static ISA const isa = [] {
+#if defined(RL_X86_KERNELS)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) { return ISA::AVX512; }
+    if (__builtin_cpu_supports("avx2")) { return ISA::AVX2; }
+#elif defined(RL_NEON_KERNELS)
+    return ISA::NEON;
+#endif
+    return ISA::Scalar;
+  }();
+  return isa;
+}
+} // namespace
+
+auto CompensatedDot(Cx const *a, Cx const *b, Index const n) -> std::complex<double>
+{
+  switch (Chosen()) {
+#if defined(RL_X86_KERNELS)
+  case ISA::AVX512: return DotAVX512(a, b, n);
+  case ISA::AVX2: return DotAVX2(a, b, n);
+#elif defined(RL_NEON_KERNELS)
+  case ISA::NEON: return DotNEON(a, b, n);
+#endif
+  default: return DotScalar(a, b, n);
+  }
+}
+
+auto CompensatedNorm2(Cx const *a, Index const n) -> double
+{
+  switch (Chosen()) {
+#if defined(RL_X86_KERNELS)
+  case ISA::AVX512: return Norm2AVX512(a, n);
+  case ISA::AVX2: return Norm2AVX2(a, n);
+#elif defined(RL_NEON_KERNELS)
+  case ISA::NEON: return Norm2NEON(a, n);
+#endif
+  default: return Norm2Scalar(a, n);
+  }
+}
+
+auto CompensatedISA() -> std::string_view
+{
+  switch (Chosen()) {
+  case ISA::AVX512: return "AVX-512";
+  case ISA::AVX2: return "AVX2";
+  case ISA::NEON: return "NEON";
+  default: return "Scalar";
+  }
+}
+
+} // namespace rl
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "../types.hpp"
+
+#include <string_view>
+
+namespace rl {
+
+/*
+ * Complex dot product Σ conj(a)·b and squared norm Σ |a|² of contiguous single-precision data. The products of two floats
+ * are exact in double precision, and are summed into double accumulators with Kahan compensation in a single pass. The
+ * kernel uses the widest SIMD instruction set available on the running CPU (AVX-512, AVX2, NEON) with a scalar fallback.
+ */
+auto CompensatedDot(Cx const *a, Cx const *b, Index const n) -> std::complex<double>;
+auto CompensatedNorm2(Cx const *a, Index const n) -> double;
+auto CompensatedISA() -> std::string_view; // Name of the instruction set chosen
+
+} // namespace rl
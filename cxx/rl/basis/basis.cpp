@@ -6,6 +6,8 @@
 #include "../sys/threads.hpp"
 #include "../tensors.hpp"
 
+#include <limits>
+
 namespace rl {
 
 Basis::Basis()
@@ -47,6 +49,28 @@ auto Basis::entry(Index const b, Index const s, Index const t) const -> Cx
   return B(b, s % B.dimension(1), t % B.dimension(2));
 }
 
+/*
+ * If every trace belongs to exactly one basis vector with weight 1 (i.e. the basis is a set of time frames or bins), return the
+ * frame index for each trace, or -1 if the trace is not in any frame. Otherwise return an empty vector.
+ */
+auto Basis::frames() const -> std::vector<int16_t>
+{
+  if (nSample() != 1 || nB() > std::numeric_limits<int16_t>::max()) { return {}; }
+  std::vector<int16_t> f(nTrace(), -1);
+  for (Index it = 0; it < nTrace(); it++) {
+    for (Index ib = 0; ib < nB(); ib++) {
+      Cx const b = B(ib, 0, it);
+      if (b == Cx(1.f)) {
+        if (f[it] >= 0) { return {}; }
+        f[it] = ib;
+      } else if (b != Cx(0.f)) {
+        return {};
+      }
+    }
+  }
+  return f;
+}
+
 void Basis::write(std::string const &basisFile) const
 {
   HD5::Writer writer(basisFile);
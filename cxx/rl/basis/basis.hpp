@@ -3,6 +3,7 @@
 #include "../types.hpp"
 
 #include <memory>
+#include <vector>
 
 namespace rl {
 
@@ -25,6 +26,7 @@ struct Basis
 
   auto entry(Index const sample, Index const trace) const -> Cx1;
   auto entry(Index const b, Index const sample, Index const trace) const -> Cx;
+  auto frames() const -> std::vector<int16_t>;
 
   void write(std::string const &basisFile) const;
   void concat(Basis const &other);
@@ -10,6 +10,9 @@
 
 #include "fmt/std.h"
 
+#include <map>
+#include <shared_mutex>
+
 namespace rl {
 namespace FFT {
 namespace internal {
@@ -40,73 +43,152 @@ private:
   Eigen::ThreadPoolInterface *pool_;
 };
 using Guard = ducc0::detail_threading::ScopedUseThreadPool;
-} // namespace internal
 
-void Shift(ducc0::vfmav<Cx> const &x, ducc0::fmav_info::shape_t const &axes)
+/*
+ *  Everything about a transform that depends only on the shape and axes - the row-major DUCC shape and axes, the unitary
+ *  scale, and the sub-array slices for the FFT shifts. DUCC keeps its own cache of twiddle factors keyed by length, so the
+ *  per-call work that is left to us is rebuilding this, which is cached here.
+ */
+struct Plan
+{
+  using Slices = std::vector<ducc0::slice>;
+  ducc0::fmav_info::shape_t              shape, axes;
+  float                                  scale;
+  std::vector<std::pair<Slices, Slices>> shifts;
+};
+
+auto MakePlan(ducc0::fmav_info::shape_t const &shape, ducc0::fmav_info::shape_t const &axes) -> Plan
 {
-  auto const ND = x.ndim();
+  auto const ND = shape.size();
   auto const N = 1 << (axes.size() - 1);
+  Plan       p{.shape = shape, .axes = axes};
+  p.scale = 1.f / std::sqrt(std::transform_reduce(axes.cbegin(), axes.cend(), 1.f, std::multiplies{},
+                                                  [&](size_t const ii) { return shape[ii]; }));
+  p.shifts.reserve(N);
+  for (Index in = 0; in < N; in++) {
+    Plan::Slices lslice(ND), rslice(ND);
+    for (Index ia = 0; ia < axes.size(); ia++) {
+      auto const a = axes[ia];
+      if (shape[a] > 1) {
+        if (shape[a] % 2 != 0) { throw Log::Failure("FFT", "Shape {} dim {} was not even", shape, a); }
+        auto const mid = shape[a] / 2;
+        if ((in >> ia) & 1) {
+          lslice[a].end = mid;
+          rslice[a].beg = mid;
+        } else {
+          lslice[a].beg = mid;
+          rslice[a].end = mid;
+        }
+      }
+    }
+    p.shifts.emplace_back(std::move(lslice), std::move(rslice));
+  }
+  return p;
+}
+
+bool planCache = true;
+
+/*
+ *  Plans are never evicted - a reconstruction only ever uses a handful of distinct shapes. std::map never invalidates
+ *  references on insertion so the returned reference stays valid after the lock is released. If the cache is disabled
+ *  the plan is rebuilt into the caller's storage instead.
+ */
+auto GetPlan(ducc0::fmav_info::shape_t const &shape, ducc0::fmav_info::shape_t const &axes, Plan &uncached) -> Plan const &
+{
+  if (!planCache) {
+    uncached = MakePlan(shape, axes);
+    return uncached;
+  }
+  using Key = std::pair<ducc0::fmav_info::shape_t, ducc0::fmav_info::shape_t>;
+  static std::map<Key, Plan> plans;
+  static std::shared_mutex   mutex;
+  Key                        key{shape, axes};
+  {
+    std::shared_lock lock(mutex);
+    if (auto const it = plans.find(key); it != plans.end()) { return it->second; }
+  }
+  Plan            p = MakePlan(shape, axes);
+  std::lock_guard lock(mutex);
+  return plans.try_emplace(std::move(key), std::move(p)).first->second;
+}
+} // namespace internal
+
+void SetPlanCache(bool const enable) { internal::planCache = enable; }
 
+void Shift(ducc0::vfmav<Cx> const &x, internal::Plan const &plan, bool const threaded = true)
+{
   auto task = [&](Index const nlo, Index const nhi) {
     for (Index in = nlo; in < nhi; in++) {
-      std::vector<ducc0::slice> lslice(ND), rslice(ND);
-      for (Index ia = 0; ia < axes.size(); ia++) {
-        auto const a = axes[ia];
-        if (x.shape()[a] > 1) {
-          if (x.shape()[a] % 2 != 0) { throw Log::Failure("FFT", "Shape {} dim {} was not even", x.shape(), a); }
-          auto const mid = x.shape()[a] / 2;
-          if ((in >> ia) & 1) {
-            lslice[a].end = mid;
-            rslice[a].beg = mid;
-          } else {
-            lslice[a].beg = mid;
-            rslice[a].end = mid;
-          }
-        }
-      }
-      ducc0::mav_apply([](Cx &a, Cx &b) { std::swap(a, b); }, 1, x.subarray(lslice), x.subarray(rslice));
+      ducc0::mav_apply([](Cx &a, Cx &b) { std::swap(a, b); }, 1, x.subarray(plan.shifts[in].first),
+                       x.subarray(plan.shifts[in].second));
     }
   };
-  Threads::ChunkFor(task, N);
+  if (threaded) {
+    Threads::ChunkFor(task, plan.shifts.size());
+  } else {
+    task(0, plan.shifts.size());
+  }
 }
 
 template <int ND, int NFFT> void Run(Eigen::TensorMap<CxN<ND>> &x, Sz<NFFT> const fftDims, bool const fwd)
 {
   auto const shape = x.dimensions();
-  /* For phase ramps */
-  Sz<ND> rsh, brd;
-  rsh.fill(1);
-  brd.fill(1);
-  for (size_t ii = 0; ii < ND; ii++) {
-    if (std::find(fftDims.begin(), fftDims.end(), ii) == fftDims.end()) {
-      brd[ii] = shape[ii];
-    } else {
-      rsh[ii] = shape[ii];
-    }
-  }
-
   /* DUCC is row-major, reverse dims */
-  std::vector<size_t> duccShape(ND), duccDims(NFFT);
+  ducc0::fmav_info::shape_t duccShape(ND), duccDims(NFFT);
   std::copy(shape.rbegin(), shape.rend(), duccShape.begin());
   std::transform(fftDims.begin(), fftDims.end(), duccDims.begin(), [](Index const d) { return ND - 1 - d; });
-  float const scale = 1.f / std::sqrt(std::transform_reduce(duccDims.cbegin(), duccDims.cend(), 1.f, std::multiplies{},
-                                                            [duccShape](size_t const ii) { return duccShape[ii]; }));
-  rl::Log::Debug("FFT", "{} Shape {} dims {} scale {}", fwd ? "Forward" : "Adjoint", duccShape, duccDims, scale);
+  internal::Plan uncached;
+  auto const    &plan = internal::GetPlan(duccShape, duccDims, uncached);
+  rl::Log::Debug("FFT", "{} Shape {} dims {} scale {}", fwd ? "Forward" : "Adjoint", plan.shape, plan.axes, plan.scale);
   internal::ThreadPool pool(Threads::TensorDevice());
   internal::Guard      guard(pool);
-  ducc0::cfmav         xc(x.data(), duccShape);
-  ducc0::vfmav         xv(x.data(), duccShape);
+  ducc0::cfmav         xc(x.data(), plan.shape);
+  ducc0::vfmav         xv(x.data(), plan.shape);
   auto                 t = Log::Now();
-  Shift(xv, duccDims);
+  Shift(xv, plan);
   rl::Log::Debug("FFT", "Shift took {}", Log::ToNow(t));
   t = Log::Now();
-  ducc0::c2c(xc, xv, duccDims, fwd, scale, pool.nthreads());
+  ducc0::c2c(xc, xv, plan.axes, fwd, plan.scale, pool.nthreads());
   rl::Log::Debug("FFT", "{} took {}", fwd ? "Forward" : "Adjoint", Log::ToNow(t));
   t = Log::Now();
-  Shift(xv, duccDims);
+  Shift(xv, plan);
   rl::Log::Debug("FFT", "Shift took {}", Log::ToNow(t));
 }
 
+template <int ND, int NFFT> void RunBatch(Eigen::TensorMap<CxN<ND>> &x, Sz<NFFT> const fftDims, Index const batchDim, bool const fwd)
+{
+  auto const shape = x.dimensions();
+  if (std::find(fftDims.begin(), fftDims.end(), batchDim) != fftDims.end()) {
+    throw Log::Failure("FFT", "Batch dimension {} is also a transform dimension {}", batchDim, fftDims);
+  }
+  ducc0::fmav_info::shape_t duccShape(ND), duccDims(NFFT);
+  std::copy(shape.rbegin(), shape.rend(), duccShape.begin());
+  std::transform(fftDims.begin(), fftDims.end(), duccDims.begin(), [](Index const d) { return ND - 1 - d; });
+  Index const duccBatch = ND - 1 - batchDim;
+  auto        batchShape = duccShape;
+  batchShape[duccBatch] = 1;
+  internal::Plan uncached;
+  auto const    &plan = internal::GetPlan(batchShape, duccDims, uncached);
+  rl::Log::Debug("FFT", "{} Batch Shape {} dims {} batches {}", fwd ? "Forward" : "Adjoint", plan.shape, plan.axes,
+                 shape[batchDim]);
+  ducc0::vfmav xv(x.data(), duccShape);
+  auto const   t = Log::Now();
+  Threads::ChunkFor(
+    [&](Index const lo, Index const hi) {
+      std::vector<ducc0::slice> slices(ND);
+      for (Index ib = lo; ib < hi; ib++) {
+        slices[duccBatch] = ducc0::slice(ib, ib + 1);
+        auto         bv = xv.subarray(slices);
+        ducc0::cfmav bc(bv.data(), bv.shape(), bv.stride());
+        Shift(bv, plan, false);
+        ducc0::c2c(bc, bv, plan.axes, fwd, plan.scale, 1);
+        Shift(bv, plan, false);
+      }
+    },
+    shape[batchDim]);
+  rl::Log::Debug("FFT", "{} Batch took {}", fwd ? "Forward" : "Adjoint", Log::ToNow(t));
+}
+
 template <int ND, int NFFT> void Forward(Eigen::TensorMap<CxN<ND>> &x, Sz<NFFT> const fftDims) { Run(x, fftDims, true); }
 
 template <int ND, int NFFT> void Forward(CxN<ND> &x, Sz<NFFT> const fftDims)
@@ -149,6 +231,19 @@ template <int ND> void Adjoint(CxN<ND> &x)
   Adjoint(map);
 }
 
+template <int ND, int NFFT> void ForwardBatch(Eigen::TensorMap<CxN<ND>> &x, Sz<NFFT> const fftDims, Index const batchDim)
+{
+  RunBatch(x, fftDims, batchDim, true);
+}
+
+template <int ND, int NFFT> void AdjointBatch(Eigen::TensorMap<CxN<ND>> &x, Sz<NFFT> const fftDims, Index const batchDim)
+{
+  RunBatch(x, fftDims, batchDim, false);
+}
+
+template void Forward<1, 1>(Cx1Map &, Sz1 const);
+template void Forward<2, 2>(Cx2Map &, Sz2 const);
+template void Forward<3, 3>(Cx3Map &, Sz3 const);
 template void Forward<4, 3>(Cx4Map &, Sz3 const);
 template void Forward<5, 3>(Cx5Map &, Sz3 const);
 template void Forward<1, 1>(Cx1 &, Sz1 const);
@@ -158,12 +253,16 @@ template void Forward<3, 2>(Cx3 &, Sz2 const);
 template void Forward<4, 1>(Cx4 &, Sz1 const);
 template void Forward<4, 2>(Cx4 &, Sz2 const);
 template void Forward<4, 3>(Cx4 &, Sz3 const);
+template void Forward<5, 1>(Cx5 &, Sz1 const);
 template void Forward<5, 2>(Cx5 &, Sz2 const);
 template void Forward<5, 3>(Cx5 &, Sz3 const);
 template void Forward<6, 3>(Cx6 &, Sz3 const);
 template void Forward<1>(Cx1 &);
 template void Forward<3>(Cx3 &);
 
+template void Adjoint<1, 1>(Cx1Map &, Sz1 const);
+template void Adjoint<2, 2>(Cx2Map &, Sz2 const);
+template void Adjoint<3, 3>(Cx3Map &, Sz3 const);
 template void Adjoint<4, 3>(Cx4Map &, Sz3 const);
 template void Adjoint<5, 3>(Cx5Map &, Sz3 const);
 template void Adjoint<2, 1>(Cx2 &, Sz1 const);
@@ -172,6 +271,7 @@ template void Adjoint<3, 2>(Cx3 &, Sz2 const);
 template void Adjoint<4, 1>(Cx4 &, Sz1 const);
 template void Adjoint<4, 2>(Cx4 &, Sz2 const);
 template void Adjoint<4, 3>(Cx4 &, Sz3 const);
+template void Adjoint<5, 1>(Cx5 &, Sz1 const);
 template void Adjoint<5, 2>(Cx5 &, Sz2 const);
 template void Adjoint<5, 3>(Cx5 &, Sz3 const);
 template void Adjoint<6, 3>(Cx6 &, Sz3 const);
@@ -180,5 +280,10 @@ template void Adjoint<1>(Cx1 &);
 template void Adjoint<2>(Cx2 &);
 template void Adjoint<3>(Cx3 &);
 
+template void ForwardBatch<4, 3>(Cx4Map &, Sz3 const, Index const);
+template void ForwardBatch<5, 3>(Cx5Map &, Sz3 const, Index const);
+template void AdjointBatch<4, 3>(Cx4Map &, Sz3 const, Index const);
+template void AdjointBatch<5, 3>(Cx5Map &, Sz3 const, Index const);
+
 } // namespace FFT
 } // namespace rl
@@ -5,6 +5,9 @@
 namespace rl {
 namespace FFT {
 
+/* Plans (shapes, scales and shift slices) are cached by default. Disabling the cache is only useful for benchmarking. */
+void SetPlanCache(bool const enable);
+
 template <int ND, int NFFT> void Forward(Eigen::TensorMap<CxN<ND>> &data, Sz<NFFT> const fftDims);
 template <int ND> void           Forward(Eigen::TensorMap<CxN<ND>> &data);
 template <int ND, int NFFT> void Forward(CxN<ND> &data, Sz<NFFT> const fftDims);
@@ -15,5 +18,12 @@ template <int ND> void           Adjoint(Eigen::TensorMap<CxN<ND>> &data);
 template <int ND, int NFFT> void Adjoint(CxN<ND> &data, Sz<NFFT> const fftDims);
 template <int ND> void           Adjoint(CxN<ND> &data);
 
+/*
+ * Batched transforms for many small FFTs. Each index along batchDim is transformed on a single thread, and the batches
+ * are spread across the thread pool, instead of threading within each transform.
+ */
+template <int ND, int NFFT> void ForwardBatch(Eigen::TensorMap<CxN<ND>> &data, Sz<NFFT> const fftDims, Index const batchDim);
+template <int ND, int NFFT> void AdjointBatch(Eigen::TensorMap<CxN<ND>> &data, Sz<NFFT> const fftDims, Index const batchDim);
+
 } // namespace FFT
 } // namespace rl
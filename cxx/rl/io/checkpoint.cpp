@@ -0,0 +1,92 @@
+#include "checkpoint.hpp"
+
+#include "../log.hpp"
+#include "reader.hpp"
+#include "writer.hpp"
+
+#include <filesystem>
+
+namespace rl {
+namespace HD5 {
+
+namespace {
+std::string const Iteration = "iteration";
+std::string const Rho = "rho";
+std::string const Residual = "residual";
+std::string const Regularizers = "regularizers";
+} // namespace
+
+Checkpointer::Checkpointer(std::string const &fname, Index const every)
+  : fname_{std::filesystem::path(fname).replace_extension(".h5").string()} // Writer always uses .h5
+  , every_{every}
+{
+  if (every_ < 1) { throw Log::Failure("HD5", "Checkpoint interval must be at least 1"); }
+}
+
+Checkpointer::~Checkpointer()
+{
+  try {
+    wait();
+  } catch (std::exception const &f) {
+    Log::Print("HD5", "Checkpoint failed: {}", f.what());
+  }
+}
+
+void Checkpointer::wait()
+{
+  if (pending_.valid()) { pending_.get(); }
+}
+
+void Checkpointer::operator()(Index const                      io,
+                              float const                      ρ,
+                              float const                      res,
+                              ADMM::Vector const              &x,
+                              std::vector<ADMM::Vector> const &z,
+                              std::vector<ADMM::Vector> const &u)
+{
+  if (io % every_) { return; }
+  wait(); // Only ever one write in flight
+  auto state = std::make_shared<ADMM::State const>(ADMM::State{io, ρ, res, x, z, u});
+  pending_ = std::async(std::launch::async, [state, fname = fname_]() {
+    auto const  lock = Lock();
+    auto const  start = Log::Now();
+    auto const  tmp = std::filesystem::path(fname).replace_extension(".tmp.h5");
+    {
+      Writer writer(tmp.string());
+      writer.writeMeta({{Iteration, static_cast<float>(state->io)},
+                        {Rho, state->ρ},
+                        {Residual, state->res},
+                        {Regularizers, static_cast<float>(state->z.size())}});
+      writer.writeMatrix(state->x, "x");
+      for (size_t ir = 0; ir < state->z.size(); ir++) {
+        writer.writeMatrix(state->z[ir], fmt::format("z{:02d}", ir));
+        writer.writeMatrix(state->u[ir], fmt::format("u{:02d}", ir));
+      }
+    }
+    std::filesystem::rename(tmp, fname);
+    Log::Print("HD5", "Wrote checkpoint {} at iteration {} in {}", fname, state->io, Log::ToNow(start));
+  });
+}
+
+auto ReadCheckpoint(std::string const &fname) -> ADMM::State
+{
+  Reader      reader(std::filesystem::path(fname).replace_extension(".h5").string());
+  auto const  meta = reader.readMeta();
+  ADMM::State state;
+  state.io = static_cast<Index>(meta.at(Iteration));
+  state.ρ = meta.at(Rho);
+  state.res = meta.at(Residual);
+  Index const R = static_cast<Index>(meta.at(Regularizers));
+  state.x = reader.readMatrix<ADMM::Vector>("x");
+  state.z.resize(R);
+  state.u.resize(R);
+  for (Index ir = 0; ir < R; ir++) {
+    state.z[ir] = reader.readMatrix<ADMM::Vector>(fmt::format("z{:02d}", ir));
+    state.u[ir] = reader.readMatrix<ADMM::Vector>(fmt::format("u{:02d}", ir));
+  }
+  Log::Print("HD5", "Read checkpoint {} at iteration {}", fname, state.io);
+  return state;
+}
+
+} // namespace HD5
+} // namespace rl
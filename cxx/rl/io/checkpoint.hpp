@@ -0,0 +1,38 @@
+#pragma once
+
+#include "../algo/admm.hpp"
+
+#include <future>
+#include <string>
+
+namespace rl {
+namespace HD5 {
+
+/*
+ * Writes the ADMM outer-loop state every N iterations. The state is copied and written on a background thread so the
+ * solver does not stall. Each checkpoint goes to a temporary file that is renamed on completion, so an interrupted
+ * write never clobbers the last good checkpoint.
+ */
+struct Checkpointer
+{
+  Checkpointer(std::string const &fname, Index const every);
+  ~Checkpointer();
+
+  void operator()(Index const io,
+                  float const ρ,
+                  float const res,
+                  ADMM::Vector const              &x,
+                  std::vector<ADMM::Vector> const &z,
+                  std::vector<ADMM::Vector> const &u);
+  void wait(); // Block until any pending write is finished, rethrowing its errors
+
+private:
+  std::string       fname_;
+  Index             every_;
+  std::future<void> pending_;
+};
+
+auto ReadCheckpoint(std::string const &fname) -> ADMM::State;
+
+} // namespace HD5
+} // namespace rl
@@ -161,6 +161,12 @@ void CheckInfoType(hid_t handle)
   }
 }
 
+auto Lock() -> std::unique_lock<std::mutex>
+{
+  static std::mutex m;
+  return std::unique_lock<std::mutex>(m);
+}
+
 auto Exists(hid_t const parent, std::string const &name) -> bool { return (H5Lexists(parent, name.c_str(), H5P_DEFAULT) > 0); }
 
 herr_t AddName(hid_t, const char *name, const H5L_info_t *, void *opdata)
@@ -2,6 +2,7 @@
 
 #include <array>
 #include <cstdint>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -31,6 +32,7 @@ auto                     Exists(Handle const h, std::string const &name) -> bool
 void                     CheckedCall(int status, std::string const &msg);
 std::string              GetError();
 std::vector<std::string> List(Handle h);
+auto                     Lock() -> std::unique_lock<std::mutex>; // HDF5 is not thread-safe, serialize background writers
 
 namespace Keys {
 std::string const Basis = "basis";
@@ -0,0 +1,46 @@
+#include "norm-cache.hpp"
+
+#include "../log.hpp"
+#include "hd5-core.hpp"
+#include "reader.hpp"
+#include "writer.hpp"
+
+#include <filesystem>
+
+namespace rl {
+namespace HD5 {
+
+auto NormKey::add(void const *data, std::size_t const bytes) -> NormKey &
+{
+  auto const p = static_cast<unsigned char const *>(data);
+  for (std::size_t ii = 0; ii < bytes; ii++) {
+    h_ = (h_ ^ p[ii]) * 1099511628211ULL;
+  }
+  return *this;
+}
+
+auto NormKey::str() const -> std::string { return fmt::format("norm-{:016x}", h_); }
+
+auto ReadNorm(std::string const &fname, NormKey const &key) -> std::optional<float>
+{
+  auto const p = std::filesystem::path(fname).replace_extension(".h5"); // Writer always uses .h5
+  if (!std::filesystem::exists(p)) { return std::nullopt; }
+  auto const        lock = Lock();
+  HD5::Reader const reader(p.string());
+  if (!reader.exists(key.str())) { return std::nullopt; }
+  float const val = reader.readMatrix<Eigen::ArrayXf>(key.str())[0];
+  Log::Print("HD5", "Read cached norm {} {:4.3E}", key.str(), val);
+  return val;
+}
+
+void WriteNorm(std::string const &fname, NormKey const &key, float const val)
+{
+  auto const           p = std::filesystem::path(fname).replace_extension(".h5");
+  auto const           lock = Lock();
+  HD5::Writer          writer(p.string(), std::filesystem::exists(p));
+  Eigen::ArrayXf const v = Eigen::ArrayXf::Constant(1, val);
+  if (!writer.exists(key.str())) { writer.writeMatrix(v, key.str()); }
+}
+
+} // namespace HD5
+} // namespace rl
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "../types.hpp"
+
+#include <optional>
+#include <string>
+
+namespace rl {
+namespace HD5 {
+
+/*
+ * Operator norms depend only on the acquisition and reconstruction set-up, not on the data, so they can be cached
+ * between runs of the same protocol. Entries are keyed by a hash of everything that defines the operator.
+ */
+struct NormKey
+{
+  auto add(void const *data, std::size_t const bytes) -> NormKey &;
+  template <typename T> auto add(T const &t) -> NormKey &
+  {
+    if constexpr (std::is_arithmetic_v<T>) {
+      return add(&t, sizeof(T));
+    } else {
+      return add(t.data(), t.size() * sizeof(*t.data()));
+    }
+  }
+  auto str() const -> std::string;
+
+private:
+  uint64_t h_ = 14695981039346656037ULL; // FNV-1a, stable across runs and platforms unlike std::hash
+};
+
+auto ReadNorm(std::string const &fname, NormKey const &key) -> std::optional<float>;
+void WriteNorm(std::string const &fname, NormKey const &key, float const val);
+
+} // namespace HD5
+} // namespace rl
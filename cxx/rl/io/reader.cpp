@@ -241,6 +241,7 @@ template auto Reader::readMatrix<Eigen::MatrixXf>(std::string const &) const ->
 template auto Reader::readMatrix<Eigen::MatrixXd>(std::string const &) const -> Eigen::MatrixXd;
 template auto Reader::readMatrix<Eigen::MatrixXcf>(std::string const &) const -> Eigen::MatrixXcf;
 template auto Reader::readMatrix<Eigen::MatrixXcd>(std::string const &) const -> Eigen::MatrixXcd;
+template auto Reader::readMatrix<Eigen::VectorXcf>(std::string const &) const -> Eigen::VectorXcf;
 
 template auto Reader::readMatrix<Eigen::ArrayXf>(std::string const &) const -> Eigen::ArrayXf;
 template auto Reader::readMatrix<Eigen::ArrayXXf>(std::string const &) const -> Eigen::ArrayXXf;
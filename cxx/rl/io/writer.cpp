@@ -194,6 +194,7 @@ template <typename Derived> void Writer::writeMatrix(Eigen::DenseBase<Derived> c
 
 template void Writer::writeMatrix<Eigen::MatrixXf>(Eigen::DenseBase<Eigen::MatrixXf> const &, std::string const &);
 template void Writer::writeMatrix<Eigen::MatrixXcf>(Eigen::DenseBase<Eigen::MatrixXcf> const &, std::string const &);
+template void Writer::writeMatrix<Eigen::VectorXcf>(Eigen::DenseBase<Eigen::VectorXcf> const &, std::string const &);
 
 template void Writer::writeMatrix<Eigen::ArrayXf>(Eigen::DenseBase<Eigen::ArrayXf> const &, std::string const &);
 template void Writer::writeMatrix<Eigen::ArrayXXf>(Eigen::DenseBase<Eigen::ArrayXXf> const &, std::string const &);
@@ -97,6 +97,7 @@ template <typename Scalar, int N>
 void Tensor(std::string const &nameIn, Sz<N> const &shape, Scalar const *data, HD5::DimensionNames<N> const &dimNames)
 {
   if (debug_file) {
+    auto const  lock = HD5::Lock();
     Index       count = 0;
     std::string name = nameIn;
     while (debug_file->exists(name)) {
@@ -0,0 +1,49 @@
+#include "multires.hpp"
+
+#include "algo/lsmr.hpp"
+#include "fft.hpp"
+#include "log.hpp"
+#include "op/pad.hpp"
+#include "tensors.hpp"
+
+namespace rl {
+
+auto FourierUpsample(Cx5 const &x, Sz5 const shape) -> Cx5
+{
+  Cx5 ks = x;
+  FFT::Forward(ks, Sz3{0, 1, 2});
+  TOps::Pad<Cx, 5> pad(x.dimensions(), shape);
+  Cx5              y = pad.forward(ks);
+  FFT::Adjoint(y, Sz3{0, 1, 2});
+  return y;
+}
+
+auto MultiresWarmStart(MultiresOpts const &opts,
+                       Recon::Opts const  &rOpts,
+                       PreconOpts const   &pOpts,
+                       GridOpts<3> const  &gridOpts,
+                       Cx5 const          &skern,
+                       Trajectory const   &traj,
+                       Basis::CPtr         basis,
+                       Cx5 const          &noncart,
+                       Sz5 const           shape) -> Ops::Op<Cx>::Vector
+{
+  if (opts.levels < 1) { return Ops::Op<Cx>::Vector(); }
+  // Pre-computed weights will not match the downsampled trajectories, and the multi-channel pre-conditioner is too slow
+  PreconOpts const lPOpts{.type = (pOpts.type == "none" || pOpts.type == "dcf") ? pOpts.type : "single", .λ = pOpts.λ};
+  Cx5              x;
+  for (Index il = opts.levels; il > 0; il--) {
+    float const ratio = std::pow(2.f, il);
+    auto const [lTraj, lKs] = traj.downsample(noncart, traj.voxelSize() * ratio, 0, true, false);
+    Log::Print("Multires", "Level {} voxel-size {} matrix {}", il, lTraj.voxelSize().transpose(), lTraj.matrix());
+    Recon const R(rOpts, lPOpts, gridOpts, skern, lTraj, basis, lKs);
+    LSMR const  lsmr{R.A, R.M, nullptr, LSMR::Opts{.imax = opts.its}};
+    if (x.size()) { x = FourierUpsample(x, R.A->ishape); }
+    auto const xl = lsmr.run(CollapseToConstVector(lKs), CollapseToConstVector(x));
+    x = AsTensorMap(xl, R.A->ishape);
+  }
+  Cx5 const x0 = FourierUpsample(x, shape);
+  return CollapseToConstVector(x0);
+}
+
+} // namespace rl
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "op/recon.hpp"
+
+namespace rl {
+
+struct MultiresOpts
+{
+  Index levels = 0; // Number of coarse levels, each halves the resolution of the previous
+  Index its = 4;    // LSMR iterations per level
+};
+
+/*
+ * Fourier interpolation over the first three dimensions, by zero-padding in k-space to the new shape. The FFTs are unitary,
+ * so the k-space values and hence the forward model are unchanged by this.
+ */
+auto FourierUpsample(Cx5 const &x, Sz5 const shape) -> Cx5;
+
+/*
+ * Coarse-to-fine warm start. Solves the least-squares problem with LSMR on successively finer matrices, starting from
+ * 2^levels times the nominal voxel size, and Fourier upsamples each solution as the starting point for the next level.
+ * Returns a starting point with the full-resolution shape, or an empty vector if levels is zero.
+ */
+auto MultiresWarmStart(MultiresOpts const &opts,
+                       Recon::Opts const  &rOpts,
+                       PreconOpts const   &pOpts,
+                       GridOpts<3> const  &gridOpts,
+                       Cx5 const          &skern,
+                       Trajectory const   &traj,
+                       Basis::CPtr         basis,
+                       Cx5 const          &noncart,
+                       Sz5 const           shape) -> Ops::Op<Cx>::Vector;
+
+} // namespace rl
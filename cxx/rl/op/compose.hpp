@@ -29,6 +29,8 @@ template <typename Op1, typename Op2> struct Compose final : TOp<typename Op1::S
   using Parent::forward;
   using Ptr = std::shared_ptr<Compose>;
 
+  auto costEstimate() const -> float final { return op1_->costEstimate() + op2_->costEstimate(); }
+
   auto forward(InTensor const &x) const -> OutTensor { return op2_->forward(op1_->forward(x)); }
   auto adjoint(OutTensor const &y) const -> InTensor { return op1_->adjoint(op2_->adjoint(y)); }
 
@@ -5,12 +5,18 @@
 
 namespace rl::TOps {
 
+namespace {
+/* Below this many points per transform, threading across transforms beats threading within them */
+Index constexpr BatchThreshold = 1 << 18;
+} // namespace
+
 template <int Rank, int FFTRank>
 FFT<Rank, FFTRank>::FFT(InDims const &shape, bool const adj)
   : Parent(fmt::format("FFT{}", adj ? " Inverse" : ""), shape, shape)
   , adjoint_{adj}
 {
   std::iota(dims_.begin(), dims_.end(), 0);
+  init();
 }
 
 template <int Rank, int FFTRank>
@@ -19,13 +25,49 @@ FFT<Rank, FFTRank>::FFT(InDims const &shape, Sz<FFTRank> const dims, bool const
   , dims_{dims}
   , adjoint_{adj}
 {
+  init();
 }
 
 template <int Rank, int FFTRank>
 FFT<Rank, FFTRank>::FFT(InMap x)
   : Parent("FFT", x.dimensions(), x.dimensions())
+  , adjoint_{false}
 {
   std::iota(dims_.begin(), dims_.end(), Rank - FFTRank);
+  init();
+}
+
+template <int Rank, int FFTRank> void FFT<Rank, FFTRank>::init()
+{
+  Index fftSize = 1;
+  for (auto const d : dims_) {
+    fftSize *= ishape[d];
+  }
+  if (fftSize > BatchThreshold) { return; }
+  for (Index ii = 0; ii < Rank; ii++) {
+    if (std::find(dims_.begin(), dims_.end(), ii) == dims_.end() && ishape[ii] > 1 &&
+        (batch_ < 0 || ishape[ii] > ishape[batch_])) {
+      batch_ = ii;
+    }
+  }
+  if (batch_ >= 0) { Log::Debug("FFT", "Batching {} transforms of size {} over dimension {}", ishape[batch_], fftSize, batch_); }
+}
+
+template <int Rank, int FFTRank> void FFT<Rank, FFTRank>::fft(InMap x, bool const fwd) const
+{
+  if (batch_ < 0) {
+    if (fwd) {
+      rl::FFT::Forward(x, dims_);
+    } else {
+      rl::FFT::Adjoint(x, dims_);
+    }
+  } else {
+    if (fwd) {
+      rl::FFT::ForwardBatch(x, dims_, batch_);
+    } else {
+      rl::FFT::AdjointBatch(x, dims_, batch_);
+    }
+  }
 }
 
 template <int Rank, int FFTRank> auto FFT<Rank, FFTRank>::inverse() const -> std::shared_ptr<rl::Ops::Op<Cx>>
@@ -37,11 +79,7 @@ template <int Rank, int FFTRank> void FFT<Rank, FFTRank>::forward(InCMap const x
 {
   auto const time = this->startForward(x, y, false);
   y = x;
-  if (adjoint_) {
-    rl::FFT::Adjoint(y, dims_);
-  } else {
-    rl::FFT::Forward(y, dims_);
-  }
+  fft(y, !adjoint_);
   this->finishForward(y, time, false);
 }
 
@@ -49,11 +87,7 @@ template <int Rank, int FFTRank> void FFT<Rank, FFTRank>::adjoint(OutCMap const
 {
   auto const time = this->startAdjoint(y, x, false);
   x = y;
-  if (adjoint_) {
-    rl::FFT::Forward(x, dims_);
-  } else {
-    rl::FFT::Adjoint(x, dims_);
-  }
+  fft(x, adjoint_);
   this->finishAdjoint(x, time, false);
 }
 
@@ -61,11 +95,7 @@ template <int Rank, int FFTRank> void FFT<Rank, FFTRank>::iforward(InCMap const
 {
   auto const time = this->startForward(x, y, true);
   InTensor   tmp = x;
-  if (adjoint_) {
-    rl::FFT::Adjoint(tmp, dims_);
-  } else {
-    rl::FFT::Forward(tmp, dims_);
-  }
+  fft(tmp, !adjoint_);
   y += tmp;
   this->finishForward(y, time, true);
 }
@@ -74,11 +104,7 @@ template <int Rank, int FFTRank> void FFT<Rank, FFTRank>::iadjoint(OutCMap const
 {
   auto const time = this->startAdjoint(y, x, true);
   InTensor   tmp = y;
-  if (adjoint_) {
-    rl::FFT::Forward(tmp, dims_);
-  } else {
-    rl::FFT::Adjoint(tmp, dims_);
-  }
+  fft(tmp, adjoint_);
   x += tmp;
   this->finishAdjoint(x, time, true);
 }
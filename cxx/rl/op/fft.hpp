@@ -26,8 +26,12 @@ template <int Rank, int FFTRank> struct FFT final : TOp<Cx, Rank, Rank>
   void iadjoint(OutCMap const y, InMap x) const;
 
 private:
+  void init();
+  void fft(InMap x, bool const fwd) const;
+
   Sz<FFTRank> dims_;
   bool        adjoint_;
+  Index       batch_ = -1; // Dimension to batch over for small transforms, -1 for a single threaded transform
 };
 
 } // namespace rl::TOps
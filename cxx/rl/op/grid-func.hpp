@@ -60,6 +60,39 @@ template <int FW> struct GFunc<1, FW>
     }
   }
 
+  /* Frame versions. Each trace contributes only to a single frame (the last grid dimension) */
+  inline static void Scatter(Eigen::Array<int16_t, 1, 1> const c,
+                             int16_t const                     sample,
+                             int32_t const                     trace,
+                             int16_t const                     frame,
+                             KT const                         &k,
+                             Cx3CMap                           y,
+                             Cx3Map                            sg)
+  {
+    for (Index ic = 0; ic < y.dimension(0); ic++) {
+      for (Index ix = 0; ix < FW; ix++) {
+        Index const iix = ix + c[0] - FW / 2;
+        sg(iix, ic, frame) += y(ic, sample, trace) * k(ix);
+      }
+    }
+  }
+
+  inline static void Gather(Eigen::Array<int16_t, 1, 1> const c,
+                            int16_t const                     sample,
+                            int32_t const                     trace,
+                            int16_t const                     frame,
+                            KT const                         &k,
+                            Cx3CMap                           sg,
+                            Cx3Map                            y)
+  {
+    for (Index ic = 0; ic < y.dimension(0); ic++) {
+      for (Index ix = 0; ix < FW; ix++) {
+        Index const iix = ix + c[0] - FW / 2;
+        y(ic, sample, trace) += sg(iix, ic, frame) * k(ix);
+      }
+    }
+  }
+
   inline static void Scatter(Basis::CPtr                       basis,
                              Eigen::Array<int16_t, 1, 1> const c,
                              int16_t const                     sample,
@@ -131,6 +164,45 @@ template <int FW> struct GFunc<2, FW>
     }
   }
 
+  /* Frame versions. Each trace contributes only to a single frame (the last grid dimension) */
+  inline static void Scatter(Eigen::Array<int16_t, 2, 1> const c,
+                             int16_t const                     sample,
+                             int32_t const                     trace,
+                             int16_t const                     frame,
+                             KT const                         &k,
+                             Cx3CMap                           y,
+                             Cx4Map                            sg)
+  {
+    for (Index ic = 0; ic < y.dimension(0); ic++) {
+      for (Index iy = 0; iy < FW; iy++) {
+        Index const iiy = iy + c[1] - FW / 2;
+        for (Index ix = 0; ix < FW; ix++) {
+          Index const iix = ix + c[0] - FW / 2;
+          sg(iix, iiy, ic, frame) += y(ic, sample, trace) * k(ix, iy);
+        }
+      }
+    }
+  }
+
+  inline static void Gather(Eigen::Array<int16_t, 2, 1> const c,
+                            int16_t const                     sample,
+                            int32_t const                     trace,
+                            int16_t const                     frame,
+                            KT const                         &k,
+                            Cx4CMap                           sg,
+                            Cx3Map                            y)
+  {
+    for (Index ic = 0; ic < y.dimension(0); ic++) {
+      for (Index iy = 0; iy < FW; iy++) {
+        Index const iiy = iy + c[1] - FW / 2;
+        for (Index ix = 0; ix < FW; ix++) {
+          Index const iix = ix + c[0] - FW / 2;
+          y(ic, sample, trace) += sg(iix, iiy, ic, frame) * k(ix, iy);
+        }
+      }
+    }
+  }
+
   inline static void Scatter(Basis::CPtr                       basis,
                              Eigen::Array<int16_t, 2, 1> const c,
                              int16_t const                     sample,
@@ -214,6 +286,51 @@ template <int FW> struct GFunc<3, FW>
     }
   }
 
+  /* Frame versions. Each trace contributes only to a single frame (the last grid dimension) */
+  inline static void Scatter(Eigen::Array<int16_t, 3, 1> const c,
+                             int16_t const                     sample,
+                             int32_t const                     trace,
+                             int16_t const                     frame,
+                             KT const                         &k,
+                             Cx3CMap                           y,
+                             Cx5Map                            sg)
+  {
+    for (Index ic = 0; ic < y.dimension(0); ic++) {
+      for (Index iz = 0; iz < FW; iz++) {
+        Index const iiz = iz + c[2] - FW / 2;
+        for (Index iy = 0; iy < FW; iy++) {
+          Index const iiy = iy + c[1] - FW / 2;
+          for (Index ix = 0; ix < FW; ix++) {
+            Index const iix = ix + c[0] - FW / 2;
+            sg(iix, iiy, iiz, ic, frame) += y(ic, sample, trace) * k(ix, iy, iz);
+          }
+        }
+      }
+    }
+  }
+
+  inline static void Gather(Eigen::Array<int16_t, 3, 1> const c,
+                            int16_t const                     sample,
+                            int32_t const                     trace,
+                            int16_t const                     frame,
+                            KT const                         &k,
+                            Cx5CMap                           sg,
+                            Cx3Map                            y)
+  {
+    for (Index ic = 0; ic < y.dimension(0); ic++) {
+      for (Index iz = 0; iz < FW; iz++) {
+        Index const iiz = iz + c[2] - FW / 2;
+        for (Index iy = 0; iy < FW; iy++) {
+          Index const iiy = iy + c[1] - FW / 2;
+          for (Index ix = 0; ix < FW; ix++) {
+            Index const iix = ix + c[0] - FW / 2;
+            y(ic, sample, trace) += sg(iix, iiy, iiz, ic, frame) * k(ix, iy, iz);
+          }
+        }
+      }
+    }
+  }
+
   inline static void Scatter(Basis::CPtr                       basis,
                              Eigen::Array<int16_t, 3, 1> const c,
                              int16_t const                     sample,
@@ -25,17 +25,25 @@ Grid<ND, KF, SG>::Grid(GridOpts<ND> const &opts, TrajectoryN<ND> const &traj, In
 {
   static_assert(ND < 4);
   auto const osMatrix = MulToEven(traj.matrixForFOV(opts.fov), opts.osamp);
-  gridLists = traj.toCoordLists(osMatrix, kernel.FullWidth, SGSZ, false);
+  {
+    Threads::InterleaveScope const interleave; // Coordinate lists are read by all threads
+    gridLists = traj.toCoordLists(osMatrix, kernel.FullWidth, SGSZ, false);
+  }
   ishape = AddBack(osMatrix, nC, basis ? basis->nB() : 1);
   oshape = Sz3{nC, traj.nSamples(), traj.nTraces()};
   mutexes = std::vector<std::mutex>(osMatrix[ND - 1]);
+  if (basis) {
+    frames = basis->frames();
+    if (frames.size()) { Log::Print("Grid", "Basis is {} frames, each trace will be gridded to one frame only", basis->nB()); }
+  }
+  subgrids = Threads::Scratch<CxN<ND + 2>>(CxN<ND + 2>(AddBack(Constant<ND>(SGFW), nC, basis ? basis->nB() : 1)));
   Log::Debug("Grid", "ishape {} oshape {}", this->ishape, this->oshape);
 }
 
 template <int ND, typename KF, int SG>
 void Grid<ND, KF, SG>::forwardTask(Index const start, Index const stride, CxNCMap<ND + 2> const x, Cx3Map y) const
 {
-  CxN<ND + 2> sx(AddBack(Constant<ND>(SGFW), y.dimension(0), basis ? basis->nB() : 1));
+  auto &sx = subgrids();
   for (Index is = start; is < gridLists.size(); is += stride) {
     auto const &list = gridLists[is];
     auto const  corner = SubgridCorner<ND, SGSZ, KF::FullWidth>(list.corner);
@@ -45,6 +53,12 @@ void Grid<ND, KF, SG>::forwardTask(Index const start, Index const stride, CxNCMa
       GridToSubgrid<ND, SGFW>::SlowCopy(corner, x, sx);
     }
     for (auto const &m : list.coords) {
+      if (frames.size()) {
+        auto const f = frames[m.trace % frames.size()];
+        if (f < 0) { continue; }
+        GFunc<ND, KF::FullWidth>::Gather(m.cart, m.sample, m.trace, f, kernel(m.offset), sx, y);
+        continue;
+      }
       auto const k = kernel(m.offset);
       if (basis) {
         GFunc<ND, KF::FullWidth>::Gather(basis, m.cart, m.sample, m.trace, k, sx, y);
@@ -74,11 +88,17 @@ template <int ND, typename KF, int SG>
 void Grid<ND, KF, SG>::adjointTask(Index const start, Index const stride, Cx3CMap const y, CxNMap<ND + 2> x) const
 
 {
-  CxN<ND + 2> sx(AddBack(Constant<ND>(SGFW), y.dimension(0), basis ? basis->nB() : 1));
+  auto &sx = subgrids();
   for (Index is = start; is < gridLists.size(); is += stride) {
     auto const &list = gridLists[is];
     sx.setZero();
     for (auto const &m : list.coords) {
+      if (frames.size()) {
+        auto const f = frames[m.trace % frames.size()];
+        if (f < 0) { continue; }
+        GFunc<ND, KF::FullWidth>::Scatter(m.cart, m.sample, m.trace, f, kernel(m.offset), y, sx);
+        continue;
+      }
       auto const k = kernel(m.offset);
       if (basis) {
         GFunc<ND, KF::FullWidth>::Scatter(basis, m.cart, m.sample, m.trace, k, y, sx);
@@ -2,6 +2,7 @@
 
 #include "../basis/basis.hpp"
 #include "../kernel/kernel.hpp"
+#include "../sys/threads.hpp"
 #include "../trajectory.hpp"
 #include "grid-opts.hpp"
 #include "top.hpp"
@@ -34,6 +35,8 @@ private:
   std::vector<CoordList> gridLists;
   std::vector<std::mutex> mutable mutexes;
   Basis::CPtr basis;
+  std::vector<int16_t> frames; // Per-trace frame index if the basis is a set of frames/bins
+  Threads::Scratch<CxN<ND + 2>> mutable subgrids;
 
   void forwardTask(Index const start, Index const stride, CxNCMap<ND + 2> const x, Cx3Map y) const;
   void adjointTask(Index const start, Index const stride, Cx3CMap const y, CxNMap<ND + 2> x) const;
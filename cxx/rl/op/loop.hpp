@@ -20,6 +20,8 @@ template <typename Op> struct Loop final : TOp<typename Op::Scalar, Op::InRank +
   {
   }
 
+  auto costEstimate() const -> float final { return N_ * op_->costEstimate(); }
+
   void forward(InCMap const x, OutMap y) const
   {
     assert(x.dimensions() == this->ishape);
@@ -1,9 +1,17 @@
 #pragma once
 
+#include "compose.hpp"
 #include "top.hpp"
 
+#include "../sys/threads.hpp"
+
 namespace rl::TOps {
 
+/*
+ * Split a volume into slabs stacked along the third (z) dimension, with the slabs moved to a new last dimension. The slab
+ * index is outermost in the output but not in the volume, so this is a reshape and shuffle rather than a pure reshape. It
+ * is done as a single threaded pass.
+ */
 template <typename Sc, int ND> struct Multiplex final : TOp<Sc, ND, ND + 1>
 {
   TOP_INHERIT(Sc, ND, ND + 1)
@@ -11,37 +19,64 @@ template <typename Sc, int ND> struct Multiplex final : TOp<Sc, ND, ND + 1>
   using Parent::forward;
 
   Multiplex(InDims const ish, Index const nSlab)
-    : Parent("MultiplexOp", ish, AddBack(FirstN<InRank - 1>(ish), ish[InRank - 1] / nSlab, nSlab))
+    : Parent("MultiplexOp", ish, SlabShape(ish, nSlab))
+  {
+    static_assert(ND > 2);
+    // Split z into (z, slab), then move the slab dimension to the end
+    for (Index ii = 0; ii < 3; ii++) {
+      split[ii] = ish[ii];
+      fwdShuffle[ii] = adjShuffle[ii] = ii;
+    }
+    split[2] = ish[2] / nSlab;
+    split[3] = nSlab;
+    for (Index ii = 3; ii < ND; ii++) {
+      split[ii + 1] = ish[ii];
+      fwdShuffle[ii] = ii + 1;
+      adjShuffle[ii + 1] = ii;
+    }
+    fwdShuffle[ND] = 3;
+    adjShuffle[3] = ND;
+  }
+
+  static auto SlabShape(InDims const ish, Index const nSlab) -> OutDims
   {
+    if (ish[2] % nSlab != 0) { throw Log::Failure("TOp", "Multiplex volume {} does not divide into {} slabs", ish, nSlab); }
+    auto sh = ish;
+    sh[2] /= nSlab;
+    return AddBack(sh, nSlab);
   }
 
   void forward(InCMap const x, OutMap y) const
   {
-    auto const  time = this->startForward(x, y, false);
-    Index const nSlab = oshape[InRank];
-    Sz<InRank>  st;
-    Sz<InRank>  sz = ishape;
-    sz[InRank - 1] /= nSlab;
-    for (Index is = 0; is < nSlab; is++) {
-      y.template chip<InRank>(is) = x.slice(st, sz);
-      st[InRank - 1] += sz[InRank - 1];
-    }
+    auto const time = this->startForward(x, y, false);
+    y.device(Threads::TensorDevice()) = x.reshape(split).shuffle(fwdShuffle);
     this->finishForward(y, time, false);
   }
 
   void adjoint(OutCMap const y, InMap x) const
   {
-    auto const  time = this->startAdjoint(y, x, false);
-    Index const nSlab = oshape[InRank];
-    Sz<InRank>  st;
-    Sz<InRank>  sz = ishape;
-    sz[InRank - 1] /= nSlab;
-    for (Index is = 0; is < nSlab; is++) {
-      x.slice(st, sz) = y.template chip<InRank>(is);
-      st[InRank - 1] += sz[InRank - 1];
-    }
+    auto const time = this->startAdjoint(y, x, false);
+    x.device(Threads::TensorDevice()) = y.shuffle(adjShuffle).reshape(ishape);
     this->finishAdjoint(x, time, false);
   }
+
+private:
+  Sz<ND + 1> split, fwdShuffle, adjShuffle;
 };
 
-} // namespace rl::TOps
\ No newline at end of file
+/*
+ * Wrap an operator whose last input dimension is slabs so that it takes the whole volume, with the slabs stacked along z.
+ */
+template <typename Op> auto MakeMultiplex(std::shared_ptr<Op> op, Index const nSlab)
+{
+  static constexpr int R = Op::InRank;
+  if (op->ishape[R - 1] != nSlab) {
+    throw Log::Failure("TOp", "Multiplex expected {} slabs but operator shape was {}", nSlab, op->ishape);
+  }
+  auto vshape = FirstN<R - 1>(op->ishape);
+  vshape[2] *= nSlab;
+  auto slabs = std::make_shared<Multiplex<typename Op::Scalar, R - 1>>(vshape, nSlab);
+  return MakeCompose(slabs, op);
+}
+
+} // namespace rl::TOps
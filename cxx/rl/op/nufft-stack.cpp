@@ -0,0 +1,188 @@
+#include "nufft-stack.hpp"
+
+#include "../fft.hpp"
+#include "../log.hpp"
+#include "../sys/threads.hpp"
+#include "top-impl.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace rl::TOps {
+
+auto NUFFTStack::Detect(GridOpts<3> const &opts, Trajectory const &traj, Basis::CPtr basis) -> std::optional<Layout>
+{
+  // The in-plane trace index is used for the basis, so it cannot vary across traces
+  if (basis && basis->nTrace() > 1) { return std::nullopt; }
+  // Partitions only lie on the Cartesian grid at the nominal FOV
+  Index const nZ = traj.matrix()[2];
+  if (nZ < 2 || traj.matrixForFOV(opts.fov)[2] != nZ) { return std::nullopt; }
+
+  float constexpr tol = 1.e-3f;
+  auto const  &p = traj.points();
+  Index const  nS = traj.nSamples();
+  Index const  nT = traj.nTraces();
+  std::vector<Index> partition(nT), inplane(nT), counts(nZ, 0);
+  for (Index it = 0; it < nT; it++) {
+    float kz = std::numeric_limits<float>::quiet_NaN();
+    for (Index is = 0; is < nS; is++) {
+      float const z = p(2, is, it);
+      if (std::isnan(z)) {
+        continue;
+      } else if (std::isnan(kz)) {
+        kz = z;
+      } else if (std::abs(z - kz) > tol) {
+        return std::nullopt;
+      }
+    }
+    if (std::isnan(kz) || std::abs(kz - std::round(kz)) > tol) { return std::nullopt; }
+    Index const iz = std::lround(kz) + nZ / 2;
+    if (iz < 0 || iz >= nZ) { return std::nullopt; }
+    partition[it] = iz;
+    inplane[it] = counts[iz]++;
+  }
+
+  // Every acquired partition must contain the same in-plane trajectory, in the same order
+  Index const        nI = counts[partition[0]];
+  std::vector<Index> ref(nI);
+  for (Index it = 0; it < nT; it++) {
+    if (partition[it] == partition[0]) { ref[inplane[it]] = it; }
+  }
+  Index nP = 0;
+  for (Index iz = 0; iz < nZ; iz++) {
+    if (counts[iz] == 0) { continue; }
+    if (counts[iz] != nI) { return std::nullopt; }
+    nP++;
+  }
+  for (Index it = 0; it < nT; it++) {
+    Index const ir = ref[inplane[it]];
+    for (Index is = 0; is < nS; is++) {
+      for (Index ii = 0; ii < 2; ii++) {
+        float const a = p(ii, is, it), b = p(ii, is, ir);
+        if (!(std::isnan(a) && std::isnan(b)) && !(std::abs(a - b) <= tol)) { return std::nullopt; }
+      }
+    }
+  }
+
+  Re3 p2(2, nS, nI);
+  for (Index ii = 0; ii < nI; ii++) {
+    p2.chip<2>(ii) = p.slice(Sz3{0, 0, ref[ii]}, Sz3{2, nS, 1}).chip<2>(0);
+  }
+  auto const mat = traj.matrix();
+  Log::Print("NUFFT", "Trajectory is a stack of {} partitions with {} traces each", nP, nI);
+  return Layout{TrajectoryN<2>(p2, Sz2{mat[0], mat[1]}, traj.voxelSize().head<2>()), partition, inplane};
+}
+
+NUFFTStack::NUFFTStack(GridOpts<3> const &opts, Trajectory const &traj, Layout const &layout, Index const nChan, Basis::CPtr basis)
+  : Parent("NUFFTStack")
+  , partition{layout.partition}
+  , inplane{layout.inplane}
+  , nZ{traj.matrix()[2]}
+  , nC{nChan}
+  , nufft{NUFFT<2>::Make(GridOpts<2>{.fov = opts.fov.head<2>(), .osamp = opts.osamp}, layout.traj, nZ * nC, basis)}
+{
+  ishape = Sz5{nufft->ishape[0], nufft->ishape[1], nZ, nC, nufft->ishape[3]};
+  oshape = Sz3{nC, traj.nSamples(), traj.nTraces()};
+  workspace.resize(ishape);
+  ks.resize(nufft->oshape);
+  Log::Print("NUFFTStack", "ishape {} oshape {} stack {}", ishape, oshape, ks.dimensions());
+}
+
+auto NUFFTStack::Make(GridOpts<3> const &opts, Trajectory const &traj, Layout const &layout, Index const nC, Basis::CPtr basis)
+  -> std::shared_ptr<NUFFTStack>
+{
+  return std::make_shared<NUFFTStack>(opts, traj, layout, nC, basis);
+}
+
+/* The FFT along z plus the 2D NUFFT of all partitions */
+auto NUFFTStack::costEstimate() const -> float { return Product(ishape) * std::log2(float(nZ)) + nufft->costEstimate(); }
+
+void NUFFTStack::fromStack(OutMap y, bool const accumulate) const
+{
+  Index const nS = oshape[1];
+  auto        task = [&](Index const lo, Index const hi) {
+    for (Index it = lo; it < hi; it++) {
+      Index const iz = partition[it], ii = inplane[it];
+      for (Index is = 0; is < nS; is++) {
+        for (Index ic = 0; ic < nC; ic++) {
+          if (accumulate) {
+            y(ic, is, it) += ks(iz + nZ * ic, is, ii);
+          } else {
+            y(ic, is, it) = ks(iz + nZ * ic, is, ii);
+          }
+        }
+      }
+    }
+  };
+  Threads::ChunkFor(task, oshape[2]);
+}
+
+void NUFFTStack::toStack(OutCMap const y) const
+{
+  Index const nS = oshape[1];
+  ks.setZero(); // Partitions that were not acquired
+  auto task = [&](Index const lo, Index const hi) {
+    for (Index it = lo; it < hi; it++) {
+      Index const iz = partition[it], ii = inplane[it];
+      for (Index is = 0; is < nS; is++) {
+        for (Index ic = 0; ic < nC; ic++) {
+          ks(iz + nZ * ic, is, ii) = y(ic, is, it);
+        }
+      }
+    }
+  };
+  Threads::ChunkFor(task, oshape[2]);
+}
+
+void NUFFTStack::forward(InCMap const x, OutMap y) const
+{
+  auto const time = this->startForward(x, y, false);
+  workspace.device(Threads::TensorDevice()) = x;
+  FFT::Forward(workspace, Sz1{2});
+  nufft->forward(NUFFT<2>::InCMap(workspace.data(), nufft->ishape), NUFFT<2>::OutMap(ks.data(), ks.dimensions()));
+  fromStack(y, false);
+  this->finishForward(y, time, false);
+}
+
+void NUFFTStack::iforward(InCMap const x, OutMap y) const
+{
+  auto const time = this->startForward(x, y, true);
+  workspace.device(Threads::TensorDevice()) = x;
+  FFT::Forward(workspace, Sz1{2});
+  nufft->forward(NUFFT<2>::InCMap(workspace.data(), nufft->ishape), NUFFT<2>::OutMap(ks.data(), ks.dimensions()));
+  fromStack(y, true);
+  this->finishForward(y, time, true);
+}
+
+void NUFFTStack::adjoint(OutCMap const y, InMap x) const
+{
+  auto const time = this->startAdjoint(y, x, false);
+  toStack(y);
+  nufft->adjoint(NUFFT<2>::OutCMap(ks.data(), ks.dimensions()), NUFFT<2>::InMap(workspace.data(), nufft->ishape));
+  FFT::Adjoint(workspace, Sz1{2});
+  x.device(Threads::TensorDevice()) = workspace;
+  this->finishAdjoint(x, time, false);
+}
+
+void NUFFTStack::iadjoint(OutCMap const y, InMap x) const
+{
+  auto const time = this->startAdjoint(y, x, true);
+  toStack(y);
+  nufft->adjoint(NUFFT<2>::OutCMap(ks.data(), ks.dimensions()), NUFFT<2>::InMap(workspace.data(), nufft->ishape));
+  FFT::Adjoint(workspace, Sz1{2});
+  x.device(Threads::TensorDevice()) += workspace;
+  this->finishAdjoint(x, time, true);
+}
+
+auto MakeNUFFT(GridOpts<3> const &opts, Trajectory const &traj, Index const nC, Basis::CPtr basis, bool const forceStack)
+  -> TOp<Cx, 5, 3>::Ptr
+{
+  if (auto const layout = NUFFTStack::Detect(opts, traj, basis)) {
+    return NUFFTStack::Make(opts, traj, *layout, nC, basis);
+  } else if (forceStack) {
+    throw Log::Failure("NUFFT", "Stack-of-stars operator requested but the trajectory is not a stack");
+  }
+  return NUFFT<3>::Make(opts, traj, nC, basis);
+}
+
+} // namespace rl::TOps
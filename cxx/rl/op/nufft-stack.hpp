@@ -0,0 +1,52 @@
+#pragma once
+
+#include "nufft.hpp"
+
+#include <optional>
+
+namespace rl::TOps {
+
+/*
+ * NUFFT for stack-of-stars/spirals. These trajectories are Cartesian along the partition (z) axis, so the 3D NUFFT separates
+ * into an FFT along z followed by a 2D NUFFT. The partitions are passed to the 2D NUFFT as extra channels, so they are gridded
+ * in parallel in a single pass sharing one 2D gridding plan.
+ */
+struct NUFFTStack final : TOp<Cx, 5, 3>
+{
+  TOP_INHERIT(Cx, 5, 3)
+  TOP_DECLARE(NUFFTStack)
+
+  struct Layout
+  {
+    TrajectoryN<2>     traj;      // In-plane trajectory, shared by all partitions
+    std::vector<Index> partition; // Partition (z index) of each trace
+    std::vector<Index> inplane;   // Index of each trace within the in-plane trajectory
+  };
+
+  //! Returns the stack layout if the trajectory is a stack of identical 2D trajectories on Cartesian partitions
+  static auto Detect(GridOpts<3> const &opts, Trajectory const &traj, Basis::CPtr basis) -> std::optional<Layout>;
+
+  NUFFTStack(GridOpts<3> const &opts, Trajectory const &traj, Layout const &layout, Index const nC, Basis::CPtr basis);
+  static auto Make(GridOpts<3> const &opts, Trajectory const &traj, Layout const &layout, Index const nC, Basis::CPtr basis)
+    -> std::shared_ptr<NUFFTStack>;
+
+  auto costEstimate() const -> float final;
+  void iadjoint(OutCMap const y, InMap x) const;
+  void iforward(InCMap const x, OutMap y) const;
+
+private:
+  std::vector<Index> partition, inplane;
+  Index              nZ, nC;
+  NUFFT<2>::Ptr      nufft;
+  InTensor mutable workspace; // Image after the FFT along z
+  Cx3 mutable ks;             // Non-cartesian data with partitions in the channel dimension
+
+  void fromStack(OutMap y, bool const accumulate) const;
+  void toStack(OutCMap const y) const;
+};
+
+//! Returns a NUFFTStack if the trajectory is a stack (or throws if forced and it is not), otherwise a full 3D NUFFT
+auto MakeNUFFT(GridOpts<3> const &opts, Trajectory const &traj, Index const nC, Basis::CPtr basis, bool const forceStack = false)
+  -> TOp<Cx, 5, 3>::Ptr;
+
+} // namespace rl::TOps
@@ -6,6 +6,7 @@
 #include "compose.hpp"
 #include "loop.hpp"
 #include "multiplex.hpp"
+#include "nufft-stack.hpp"
 #include "reshape.hpp"
 #include "top-impl.hpp"
 
@@ -15,8 +16,16 @@ template <int ND, typename KF>
 NUFFT<ND, KF>::NUFFT(GridOpts<ND> const &opts, TrajectoryN<ND> const &traj, Index const nChan, Basis::CPtr basis)
   : Parent("NUFFT")
   , gridder{opts, traj, nChan, basis}
-  , workspace{gridder.ishape}
 {
+  size_t const wsBytes = Product(gridder.ishape) * sizeof(Cx);
+  if (OverBudget(wsBytes)) {
+    Log::Print("NUFFT", "Grid {} exceeds memory budget, using out-of-core workspace", gridder.ishape);
+    scratch_ = std::make_unique<ScratchFile>(wsBytes);
+    ws_ = static_cast<Cx *>(scratch_->data());
+  } else {
+    workspace.resize(gridder.ishape);
+    ws_ = workspace.data();
+  }
   ishape = Concatenate(traj.matrixForFOV(opts.fov), LastN<2>(gridder.ishape));
   oshape = gridder.oshape;
   std::iota(fftDims.begin(), fftDims.end(), 0);
@@ -48,43 +57,79 @@ auto NUFFT<ND, KF>::Make(GridOpts<ND> const &opts, TrajectoryN<ND> const &traj,
   return std::make_shared<NUFFT<ND, KF>>(opts, traj, nChan, basis);
 }
 
+/* The FFT of the grid plus a kernel footprint per sample */
+template <int ND, typename KF> auto NUFFT<ND, KF>::costEstimate() const -> float
+{
+  float const nGrid = Product(gridder.ishape);
+  return nGrid * std::log2(nGrid) + Product(oshape) * std::pow(float(KF::FullWidth), ND) * gridder.ishape[ND + 1];
+}
+
+/*
+ *  In memory this is a single FFT over all channels and basis vectors. Out-of-core the grid is transformed one volume
+ *  at a time, each of which is contiguous, while the kernel reads ahead the next volume and writes back the previous one.
+ */
+template <int ND, typename KF> void NUFFT<ND, KF>::fft(bool const fwd) const
+{
+  if (!scratch_) {
+    if (fwd) {
+      FFT::Forward(workspace, fftDims);
+    } else {
+      FFT::Adjoint(workspace, fftDims);
+    }
+    return;
+  }
+  auto const   vshape = FirstN<ND>(gridder.ishape);
+  Index const  nV = Product(LastN<2>(gridder.ishape));
+  size_t const vBytes = Product(vshape) * sizeof(Cx);
+  for (Index iv = 0; iv < nV; iv++) {
+    if (iv + 1 < nV) { scratch_->prefetch((iv + 1) * vBytes, vBytes); }
+    Eigen::TensorMap<CxN<ND>> vol(ws_ + iv * Product(vshape), vshape);
+    if (fwd) {
+      FFT::Forward(vol, fftDims);
+    } else {
+      FFT::Adjoint(vol, fftDims);
+    }
+    scratch_->writeback(iv * vBytes, vBytes);
+  }
+}
+
 template <int ND, typename KF> void NUFFT<ND, KF>::forward(InCMap const x, OutMap y) const
 {
   auto const time = this->startForward(x, y, false);
-  InMap      wsm(workspace.data(), gridder.ishape);
+  InMap      wsm(ws_, gridder.ishape);
   wsm.device(Threads::TensorDevice()) = (x * apo_.broadcast(apoBrd_)).pad(paddings_);
-  FFT::Forward(workspace, fftDims);
-  gridder.forward(workspace, y);
+  fft(true);
+  gridder.forward(InCMap(ws_, gridder.ishape), y);
   this->finishForward(y, time, false);
 }
 
 template <int ND, typename KF> void NUFFT<ND, KF>::adjoint(OutCMap const y, InMap x) const
 {
   auto const time = this->startAdjoint(y, x, false);
-  InMap      wsm(workspace.data(), gridder.ishape);
+  InMap      wsm(ws_, gridder.ishape);
   gridder.adjoint(y, wsm);
-  FFT::Adjoint(workspace, fftDims);
-  x.device(Threads::TensorDevice()) = workspace.slice(padLeft_, ishape) * apo_.broadcast(apoBrd_);
+  fft(false);
+  x.device(Threads::TensorDevice()) = wsm.slice(padLeft_, ishape) * apo_.broadcast(apoBrd_);
   this->finishAdjoint(x, time, false);
 }
 
 template <int ND, typename KF> void NUFFT<ND, KF>::iforward(InCMap const x, OutMap y) const
 {
   auto const time = this->startForward(x, y, true);
-  InMap      wsm(workspace.data(), gridder.ishape);
+  InMap      wsm(ws_, gridder.ishape);
   wsm.device(Threads::TensorDevice()) = (x * apo_.broadcast(apoBrd_)).pad(paddings_);
-  FFT::Forward(workspace, fftDims);
-  gridder.iforward(workspace, y);
+  fft(true);
+  gridder.iforward(InCMap(ws_, gridder.ishape), y);
   this->finishForward(y, time, true);
 }
 
 template <int ND, typename KF> void NUFFT<ND, KF>::iadjoint(OutCMap const y, InMap x) const
 {
   auto const time = this->startAdjoint(y, x, true);
-  InMap      wsm(workspace.data(), gridder.ishape);
+  InMap      wsm(ws_, gridder.ishape);
   gridder.adjoint(y, wsm);
-  FFT::Adjoint(workspace, fftDims);
-  x.device(Threads::TensorDevice()) += workspace.slice(padLeft_, ishape) * apo_.broadcast(apoBrd_);
+  fft(false);
+  x.device(Threads::TensorDevice()) += wsm.slice(padLeft_, ishape) * apo_.broadcast(apoBrd_);
   this->finishAdjoint(x, time, true);
 }
 
@@ -96,16 +141,15 @@ auto NUFFTAll(
   GridOpts<3> const &gridOpts, Trajectory const &traj, Index const nC, Index const nSlab, Index const nTime, Basis::CPtr basis)
   -> TOps::TOp<Cx, 6, 5>::Ptr
 {
-  auto nufft = TOps::NUFFT<3>::Make(gridOpts, traj, nC, basis);
+  auto nufft = TOps::MakeNUFFT(gridOpts, traj, nC, basis);
   if (nSlab == 1) {
     auto reshape = TOps::MakeReshapeOutput(nufft, AddBack(nufft->oshape, 1));
     auto timeLoop = TOps::MakeLoop(reshape, nTime);
     return timeLoop;
   } else {
     auto loop = TOps::MakeLoop(nufft, nSlab);
-    auto slabToVol = std::make_shared<TOps::Multiplex<Cx, 5>>(nufft->ishape, nSlab);
-    auto compose1 = TOps::MakeCompose(slabToVol, loop);
-    auto timeLoop = TOps::MakeLoop(compose1, nTime);
+    auto slabToVol = TOps::MakeMultiplex(loop, nSlab);
+    auto timeLoop = TOps::MakeLoop(slabToVol, nTime);
     return timeLoop;
   }
 }
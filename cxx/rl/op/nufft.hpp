@@ -3,6 +3,9 @@
 #include "../op/grid.hpp"
 #include "../op/pad.hpp"
 #include "../op/top.hpp"
+#include "../sys/scratch.hpp"
+
+#include <memory>
 
 namespace rl::TOps {
 
@@ -17,13 +20,18 @@ template <int ND, typename KF = rl::ExpSemi<4>> struct NUFFT final : TOp<Cx, ND
 
   void iadjoint(OutCMap const y, InMap x) const;
   void iforward(InCMap const x, OutMap y) const;
+  auto costEstimate() const -> float final;
 
 private:
-  Grid<ND, KF> gridder;
-  InTensor mutable workspace;
-  Sz<ND>   fftDims;
-  InTensor apo_;
-  InDims   apoBrd_, padLeft_;
+  void fft(bool const fwd) const;
+
+  Grid<ND, KF>                 gridder;
+  InTensor mutable             workspace;
+  std::unique_ptr<ScratchFile> scratch_; // Out-of-core workspace when the grid exceeds the memory budget
+  Cx                          *ws_;
+  Sz<ND>                       fftDims;
+  InTensor                     apo_;
+  InDims                       apoBrd_, padLeft_;
 
   std::array<std::pair<Index, Index>, ND + 2> paddings_;
 };
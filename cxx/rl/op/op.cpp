@@ -13,6 +13,16 @@ Op<S>::Op(std::string const &n)
 {
 }
 
+namespace {
+bool concurrentStacks = false;
+}
+
+void SetConcurrentStacks(bool const enable) { concurrentStacks = enable; }
+auto ConcurrentStacks() -> bool { return concurrentStacks; }
+
+/* By default assume cost scales with the amount of data touched */
+template <typename S> auto Op<S>::costEstimate() const -> float { return rows() + cols(); }
+
 template <typename S> void Op<S>::inverse(CMap const , Map ) const
 {
   throw Log::Failure("Op", "{} does not have an inverse defined", name);
@@ -20,6 +20,7 @@ template <typename Scalar_ = Cx> struct Op
 
   virtual auto rows() const -> Index = 0;
   virtual auto cols() const -> Index = 0;
+  virtual auto costEstimate() const -> float; // Relative cost of one application, used to schedule concurrent blocks
 
   virtual void forward(CMap const x, Map y) const = 0;
   virtual void adjoint(CMap const y, Map x) const = 0;
@@ -49,6 +50,15 @@ protected:
   void finishInverse(Map const &x, Time const start, bool const ip) const;
 };
 
+/*
+ * When enabled, VStack and DStack apply their blocks as concurrent tasks, most expensive first, with the thread pool shared
+ * dynamically between them. A stack falls back to running its blocks in order if the same operator appears twice, but
+ * only the top-level blocks are compared. Operators with mutable workspaces (e.g. Multiply, NUFFT) must not be shared
+ * between the children of two different blocks, as those would then race.
+ */
+void SetConcurrentStacks(bool const enable);
+auto ConcurrentStacks() -> bool;
+
 #define OP_INHERIT                                                                                                             \
   using typename Op<Scalar>::Vector;                                                                                           \
   using typename Op<Scalar>::Map;                                                                                              \
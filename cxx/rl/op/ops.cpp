@@ -5,6 +5,57 @@
 
 namespace rl::Ops {
 
+namespace {
+template <typename S> auto TotalCost(std::vector<std::shared_ptr<Op<S>>> const &ops) -> float
+{
+  return std::accumulate(ops.begin(), ops.end(), 0.f, [](float a, auto const &op) { return a + op->costEstimate(); });
+}
+
+/*
+ * Blocks can run concurrently if enabled, if no operator appears twice (operators hold mutable workspaces), and if there
+ * are at least two threads per block, which leaves threads free to run the blocks' own parallel loops.
+ */
+template <typename S> auto Concurrent(std::vector<std::shared_ptr<Op<S>>> const &ops) -> bool
+{
+  Index const nB = ops.size();
+  if (!ConcurrentStacks() || nB < 2 || 2 * nB > Threads::GlobalThreadCount()) { return false; }
+  for (Index ii = 0; ii < nB; ii++) {
+    if (std::find(ops.begin() + ii + 1, ops.end(), ops[ii]) != ops.end()) { return false; }
+  }
+  return true;
+}
+
+/*
+ * Call f(ii) for each block, concurrently if possible with the most expensive blocks started first. The most expensive
+ * runs on the calling thread, so that when called from outside the pool its FFTs can still use every thread.
+ */
+template <typename S, typename F> void ForEachBlock(std::vector<std::shared_ptr<Op<S>>> const &ops, F const &f)
+{
+  Index const nB = ops.size();
+  if (!Concurrent(ops)) {
+    for (Index ii = 0; ii < nB; ii++) {
+      f(ii);
+    }
+    return;
+  }
+  std::vector<Index> order(nB);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](Index a, Index b) { return ops[a]->costEstimate() > ops[b]->costEstimate(); });
+  Threads::CallerFirst(nB, [&](Index const ii) { f(order[ii]); });
+}
+
+template <typename S> auto Starts(std::vector<std::shared_ptr<Op<S>>> const &ops, bool const rows) -> std::vector<Index>
+{
+  std::vector<Index> starts(ops.size());
+  Index              st = 0;
+  for (size_t ii = 0; ii < ops.size(); ii++) {
+    starts[ii] = st;
+    st += rows ? ops[ii]->rows() : ops[ii]->cols();
+  }
+  return starts;
+}
+} // namespace
+
 template <typename S>
 Identity<S>::Identity(Index const s)
   : Op<S>("Identity")
@@ -284,6 +335,8 @@ template <typename S> void Multiply<S>::iadjoint(CMap const y, Map x) const
   this->finishAdjoint(x, time, true);
 }
 
+template <typename S> auto Multiply<S>::costEstimate() const -> float { return A->costEstimate() + B->costEstimate(); }
+
 template struct Multiply<float>;
 template struct Multiply<Cx>;
 
@@ -338,54 +391,72 @@ template <typename S> auto VStack<S>::rows() const -> Index
 
 template <typename S> auto VStack<S>::cols() const -> Index { return ops.front()->cols(); }
 
+template <typename S> auto VStack<S>::costEstimate() const -> float { return TotalCost(ops); }
+
 template <typename S> void VStack<S>::forward(CMap const x, Map y) const
 {
   auto const time = this->startForward(x, y, false);
-  Index      ir = 0;
-  for (auto const &op : ops) {
-    Map ym(y.data() + ir, op->rows());
-    ir += op->rows();
-    op->forward(x, ym);
-  }
+  auto const rs = Starts(ops, true);
+  ForEachBlock(ops, [&](Index const ii) {
+    Map ym(y.data() + rs[ii], ops[ii]->rows());
+    ops[ii]->forward(x, ym);
+  });
   this->finishForward(y, time, false);
 }
 
+/*
+ * The blocks' adjoints all sum into x. Serially they can add in-place, concurrently all but the first write to their own
+ * temporaries, which are summed afterwards.
+ */
+template <typename S> void VStack<S>::adjointBlocks(CMap const y, Map x, bool const ip) const
+{
+  auto const rs = Starts(ops, true);
+  if (!ip) { x.setConstant(0.f); }
+  if (!Concurrent(ops)) {
+    for (size_t ii = 0; ii < ops.size(); ii++) {
+      CMap ym(y.data() + rs[ii], ops[ii]->rows());
+      ops[ii]->iadjoint(ym, x);
+    }
+    return;
+  }
+  if (temps.size() != ops.size() - 1) { temps.resize(ops.size() - 1); }
+  ForEachBlock(ops, [&](Index const ii) {
+    CMap ym(y.data() + rs[ii], ops[ii]->rows());
+    if (ii == 0) {
+      ops[ii]->iadjoint(ym, x);
+    } else {
+      auto &t = temps[ii - 1];
+      if (t.size() != x.size()) { t.resize(x.size()); }
+      ops[ii]->adjoint(ym, Map(t.data(), t.size()));
+    }
+  });
+  for (auto const &t : temps) {
+    x.device(Threads::CoreDevice()) += t;
+  }
+}
+
 template <typename S> void VStack<S>::adjoint(CMap const y, Map x) const
 {
   auto const time = this->startAdjoint(y, x, false);
-  Map        xtm(x.data(), x.rows());
-  x.setConstant(0.f);
-  Index ir = 0;
-  for (auto const &op : ops) {
-    CMap ym(y.data() + ir, op->rows());
-    ir += op->rows();
-    op->iadjoint(ym, xtm); // Need to sum, use the in-place version
-  }
+  adjointBlocks(y, x, false);
   this->finishAdjoint(x, time, false);
 }
 
 template <typename S> void VStack<S>::iforward(CMap const x, Map y) const
 {
   auto const time = this->startForward(x, y, true);
-  Index      ir = 0;
-  for (auto const &op : ops) {
-    Map ym(y.data() + ir, op->rows());
-    ir += op->rows();
-    op->iforward(x, ym);
-  }
+  auto const rs = Starts(ops, true);
+  ForEachBlock(ops, [&](Index const ii) {
+    Map ym(y.data() + rs[ii], ops[ii]->rows());
+    ops[ii]->iforward(x, ym);
+  });
   this->finishForward(y, time, true);
 }
 
 template <typename S> void VStack<S>::iadjoint(CMap const y, Map x) const
 {
   auto const time = this->startAdjoint(y, x, true);
-  Map        xtm(x.data(), x.rows());
-  Index      ir = 0;
-  for (auto const &op : ops) {
-    CMap ym(y.data() + ir, op->rows());
-    ir += op->rows();
-    op->iadjoint(ym, xtm);
-  }
+  adjointBlocks(y, x, true);
   this->finishAdjoint(x, time, true);
 }
 
@@ -510,83 +581,70 @@ template <typename S> auto DStack<S>::cols() const -> Index
   return std::accumulate(this->ops.begin(), this->ops.end(), 0L, [](Index a, auto const &op) { return a + op->cols(); });
 }
 
+template <typename S> auto DStack<S>::costEstimate() const -> float { return TotalCost(ops); }
+
 template <typename S> void DStack<S>::forward(CMap const x, Map y) const
 {
   auto const time = this->startForward(x, y, false);
-  Index      ir = 0, ic = 0;
-  for (auto const &op : ops) {
-    CMap xm(x.data() + ic, op->cols());
-    Map  ym(y.data() + ir, op->rows());
-    op->forward(xm, ym);
-    ir += op->rows();
-    ic += op->cols();
-  }
-  assert(ir == rows());
-  assert(ic == cols());
+  auto const rs = Starts(ops, true);
+  auto const cs = Starts(ops, false);
+  ForEachBlock(ops, [&](Index const ii) {
+    CMap xm(x.data() + cs[ii], ops[ii]->cols());
+    Map  ym(y.data() + rs[ii], ops[ii]->rows());
+    ops[ii]->forward(xm, ym);
+  });
   this->finishForward(y, time, false);
 }
 
 template <typename S> void DStack<S>::adjoint(CMap const y, Map x) const
 {
   auto const time = this->startAdjoint(y, x, false);
-  Index      ir = 0, ic = 0;
-  for (auto const &op : ops) {
-    Map  xm(x.data() + ic, op->cols());
-    CMap ym(y.data() + ir, op->rows());
-    op->adjoint(ym, xm);
-    ir += op->rows();
-    ic += op->cols();
-  }
-  assert(ir == rows());
-  assert(ic == cols());
+  auto const rs = Starts(ops, true);
+  auto const cs = Starts(ops, false);
+  ForEachBlock(ops, [&](Index const ii) {
+    Map  xm(x.data() + cs[ii], ops[ii]->cols());
+    CMap ym(y.data() + rs[ii], ops[ii]->rows());
+    ops[ii]->adjoint(ym, xm);
+  });
   this->finishAdjoint(x, time, false);
 }
 
 template <typename S> void DStack<S>::inverse(CMap const y, Map x) const
 {
   auto const time = this->startInverse(y, x, false);
-  Index      ir = 0, ic = 0;
-  for (auto const &op : ops) {
-    Map  xm(x.data() + ic, op->cols());
-    CMap ym(y.data() + ir, op->rows());
-    op->inverse(ym, xm);
-    ir += op->rows();
-    ic += op->cols();
-  }
-  assert(ir == rows());
-  assert(ic == cols());
+  auto const rs = Starts(ops, true);
+  auto const cs = Starts(ops, false);
+  ForEachBlock(ops, [&](Index const ii) {
+    Map  xm(x.data() + cs[ii], ops[ii]->cols());
+    CMap ym(y.data() + rs[ii], ops[ii]->rows());
+    ops[ii]->inverse(ym, xm);
+  });
   this->finishInverse(x, time, false);
 }
 
 template <typename S> void DStack<S>::iforward(CMap const x, Map y) const
 {
   auto const time = this->startForward(x, y, true);
-  Index      ir = 0, ic = 0;
-  for (auto const &op : ops) {
-    CMap xm(x.data() + ic, op->cols());
-    Map  ym(y.data() + ir, op->rows());
-    op->iforward(xm, ym);
-    ir += op->rows();
-    ic += op->cols();
-  }
-  assert(ir == rows());
-  assert(ic == cols());
+  auto const rs = Starts(ops, true);
+  auto const cs = Starts(ops, false);
+  ForEachBlock(ops, [&](Index const ii) {
+    CMap xm(x.data() + cs[ii], ops[ii]->cols());
+    Map  ym(y.data() + rs[ii], ops[ii]->rows());
+    ops[ii]->iforward(xm, ym);
+  });
   this->finishForward(y, time, true);
 }
 
 template <typename S> void DStack<S>::iadjoint(CMap const y, Map x) const
 {
   auto const time = this->startAdjoint(y, x, true);
-  Index      ir = 0, ic = 0;
-  for (auto const &op : ops) {
-    Map  xm(x.data() + ic, op->cols());
-    CMap ym(y.data() + ir, op->rows());
-    op->iadjoint(ym, xm);
-    ir += op->rows();
-    ic += op->cols();
-  }
-  assert(ir == rows());
-  assert(ic == cols());
+  auto const rs = Starts(ops, true);
+  auto const cs = Starts(ops, false);
+  ForEachBlock(ops, [&](Index const ii) {
+    Map  xm(x.data() + cs[ii], ops[ii]->cols());
+    CMap ym(y.data() + rs[ii], ops[ii]->rows());
+    ops[ii]->iadjoint(ym, xm);
+  });
   this->finishAdjoint(x, time, true);
 }
 
@@ -70,6 +70,7 @@ template <typename Scalar = Cx> struct Multiply final : Op<Scalar>
 {
   OP_INHERIT
   Multiply(std::shared_ptr<Op<Scalar>> A, std::shared_ptr<Op<Scalar>> B);
+  auto costEstimate() const -> float final;
   auto inverse() const -> std::shared_ptr<Op<Scalar>> final;
   void forward(CMap const x, Map y) const;
   void adjoint(CMap const y, Map x) const;
@@ -91,6 +92,7 @@ template <typename Scalar = Cx> struct VStack final : Op<Scalar>
   VStack(std::vector<std::shared_ptr<Op<Scalar>>> const &o);
   VStack(std::shared_ptr<Op<Scalar>> op1, std::shared_ptr<Op<Scalar>> op2);
   VStack(std::shared_ptr<Op<Scalar>> op1, std::vector<std::shared_ptr<Op<Scalar>>> const &others);
+  auto costEstimate() const -> float final;
   void forward(CMap const x, Map y) const;
   void adjoint(CMap const y, Map x) const;
   void iforward(CMap const x, Map y) const;
@@ -98,7 +100,9 @@ template <typename Scalar = Cx> struct VStack final : Op<Scalar>
 
 private:
   void                                     check();
+  void                                     adjointBlocks(CMap const y, Map x, bool const ip) const;
   std::vector<std::shared_ptr<Op<Scalar>>> ops;
+  std::vector<Vector> mutable temps; // Per-block adjoint results when running concurrently
 };
 
 //! Horizontally stack operators, i.e. A = [B C]
@@ -124,6 +128,7 @@ template <typename Scalar = Cx> struct DStack final : Op<Scalar>
   OP_INHERIT
   DStack(std::vector<std::shared_ptr<Op<Scalar>>> const &o);
   DStack(std::shared_ptr<Op<Scalar>> op1, std::shared_ptr<Op<Scalar>> op2);
+  auto                                     costEstimate() const -> float final;
   auto                                     inverse() const -> std::shared_ptr<Op<Scalar>> final;
   void                                     forward(CMap const x, Map y) const;
   void                                     adjoint(CMap const y, Map x) const;
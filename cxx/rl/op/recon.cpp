@@ -6,17 +6,19 @@
 #include "ndft.hpp"
 #include "nufft-decant.hpp"
 #include "nufft-lowmem.hpp"
+#include "nufft-stack.hpp"
 #include "nufft.hpp"
 #include "reshape.hpp"
 #include "sense.hpp"
 
 namespace rl {
 
-auto Single(GridOpts<3> const &gridOpts, Trajectory const &traj, Index const nSlab, Index const nTime, Basis::CPtr b)
+auto Single(
+  GridOpts<3> const &gridOpts, Trajectory const &traj, Index const nSlab, Index const nTime, Basis::CPtr b, bool const stack)
   -> TOps::TOp<Cx, 5, 5>::Ptr
 {
   if (nSlab > 1) { throw Log::Failure("Recon", "Multislab and 1 channel not supported right now"); }
-  auto nufft = TOps::NUFFT<3>::Make(gridOpts, traj, 1, b);
+  auto nufft = TOps::MakeNUFFT(gridOpts, traj, 1, b, stack);
   auto ri = TOps::MakeReshapeInput(nufft, LastN<4>(nufft->ishape));
   auto ro = TOps::MakeReshapeOutput(ri, AddBack(ri->oshape, 1));
   auto timeLoop = TOps::MakeLoop(ro, nTime);
@@ -36,16 +38,20 @@ auto LowmemSENSE(
   }
 }
 
-auto SENSERecon(
-  GridOpts<3> const &gridOpts, Trajectory const &traj, Index const nSlab, Index const nTime, Basis::CPtr b, Cx5 const &smaps)
-  -> TOps::TOp<Cx, 5, 5>::Ptr
+auto SENSERecon(GridOpts<3> const &gridOpts,
+                Trajectory const  &traj,
+                Index const        nSlab,
+                Index const        nTime,
+                Basis::CPtr        b,
+                Cx5 const         &smaps,
+                bool const         stack) -> TOps::TOp<Cx, 5, 5>::Ptr
 {
   auto sense = std::make_shared<TOps::SENSE>(smaps, b ? b->nB() : 1);
-  auto nufft = TOps::NUFFT<3>::Make(gridOpts, traj, smaps.dimension(3), b);
+  auto nufft = TOps::MakeNUFFT(gridOpts, traj, smaps.dimension(3), b, stack);
   auto slabLoop = TOps::MakeLoop(nufft, nSlab);
   if (nSlab > 1) {
-    auto slabToVol = std::make_shared<TOps::Multiplex<Cx, 5>>(sense->oshape, nSlab);
-    return TOps::MakeLoop(TOps::MakeCompose(sense, TOps::MakeCompose(slabToVol, slabLoop)), nTime);
+    auto slabToVol = TOps::MakeMultiplex(slabLoop, nSlab);
+    return TOps::MakeLoop(TOps::MakeCompose(sense, slabToVol), nTime);
   } else {
     auto reshape = TOps::MakeReshapeOutput(sense, AddBack(sense->oshape, 1));
     auto recon = TOps::MakeLoop(TOps::MakeCompose(reshape, slabLoop), nTime);
@@ -74,14 +80,33 @@ Recon::Recon(Opts const        &rOpts,
              Trajectory const  &traj,
              Basis::CPtr        b,
              Cx5 const         &noncart)
+  : Recon(rOpts,
+          pOpts,
+          gridOpts,
+          noncart.dimension(0) > 1 ? SENSE::Choose(senseOpts, gridOpts, traj, noncart) : Cx5(),
+          traj,
+          b,
+          noncart)
+{
+}
+
+Recon::Recon(Opts const        &rOpts,
+             PreconOpts const  &pOpts,
+             GridOpts<3> const &gridOpts,
+             Cx5 const         &skern,
+             Trajectory const  &traj,
+             Basis::CPtr        b,
+             Cx5 const         &noncart)
 {
   Index const nC = noncart.dimension(0);
   Index const nS = noncart.dimension(3);
   Index const nT = noncart.dimension(4);
+  if (rOpts.stack && (rOpts.decant || rOpts.lowmem)) {
+    throw Log::Failure("Recon", "Stack-of-stars NUFFT is not available with decant or lowmem");
+  }
   if (nC == 1) {
-    A = Single(gridOpts, traj, nS, nT, b);
+    A = Single(gridOpts, traj, nS, nT, b, rOpts.stack);
   } else {
-    auto const skern = SENSE::Choose(senseOpts, gridOpts, traj, noncart);
     if (rOpts.decant) {
       A = Decant(gridOpts, traj, nS, nT, b, skern);
       M = MakeKSpacePrecon(pOpts, gridOpts, traj, nC, nS, nT);
@@ -89,11 +114,13 @@ Recon::Recon(Opts const        &rOpts,
       A = LowmemSENSE(gridOpts, traj, nS, nT, b, skern);
       M = MakeKSpacePrecon(pOpts, gridOpts, traj, nC, nS, nT);
     } else {
-      Cx5 const smaps = SENSE::KernelsToMaps(skern, traj.matrixForFOV(gridOpts.fov), gridOpts.osamp);
+      Sz3 mat = traj.matrixForFOV(gridOpts.fov);
+      mat[2] *= nS; // SENSE applies to the whole volume with the slabs stacked along z
+      Cx5 const smaps = SENSE::KernelsToMaps(skern, mat, gridOpts.osamp);
       M = MakeKSpacePrecon(pOpts, gridOpts, traj, smaps, nS, nT); // In case the SENSE op does move
-      A = SENSERecon(gridOpts, traj, nS, nT, b, smaps);
+      A = SENSERecon(gridOpts, traj, nS, nT, b, smaps, rOpts.stack);
     }
   }
 }
 
-} // namespace rl
\ No newline at end of file
+} // namespace rl
@@ -15,6 +15,7 @@ struct Recon
   struct Opts
   {
     bool decant, lowmem;
+    bool stack; // Require the stack-of-stars NUFFT, otherwise it is used only if detected
   };
 
   Recon(Opts const        &rOpts,
@@ -24,6 +25,22 @@ struct Recon
         Trajectory const  &traj,
         Basis::CPtr        basis,
         Cx5 const         &data);
+  Recon(Opts const        &rOpts,
+        PreconOpts const  &pOpts,
+        GridOpts<3> const &gridOpts,
+        Cx5 const         &skern, // Pre-calibrated SENSE kernels, ignored for single-channel data
+        Trajectory const  &traj,
+        Basis::CPtr        basis,
+        Cx5 const         &data);
   TOps::TOp<Cx, 5, 5>::Ptr A, M;
 };
+
+//! The SENSE operator applies to the whole volume, multiple slabs are stacked along z
+auto SENSERecon(GridOpts<3> const &gridOpts,
+                Trajectory const  &traj,
+                Index const        nSlab,
+                Index const        nTime,
+                Basis::CPtr        b,
+                Cx5 const         &smaps,
+                bool const         stack) -> TOps::TOp<Cx, 5, 5>::Ptr;
 } // namespace rl
\ No newline at end of file
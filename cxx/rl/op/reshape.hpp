@@ -22,6 +22,8 @@ template <typename Op, int Rank> struct ReshapeInput final : TOp<typename Op::Sc
     }
   }
 
+  auto costEstimate() const -> float final { return op_->costEstimate(); }
+
   void forward(InCMap const x, OutMap y) const
   {
     auto const                time = this->startForward(x, y, false);
@@ -84,6 +86,8 @@ template <typename Op, int Rank> struct ReshapeOutput final : TOp<typename Op::S
     }
   }
 
+  auto costEstimate() const -> float final { return op_->costEstimate(); }
+
   void forward(InCMap const x, OutMap y) const
   {
     auto const                time = this->startForward(x, y, false);
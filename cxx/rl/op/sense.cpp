@@ -13,6 +13,7 @@ SENSE::SENSE(Cx5 const &maps, Index const nB)
            AddBack(FirstN<3>(maps.dimensions()), maps.dimension(3), nB))
   , maps_{maps}
 {
+  Threads::Interleave(maps_.data(), maps_.size() * sizeof(Cx)); // Read by all threads
   resX.set(0, maps_.dimension(0));
   resX.set(1, maps_.dimension(1));
   resX.set(2, maps_.dimension(2));
@@ -4,8 +4,20 @@
 
 namespace rl {
 
-void Patches(
-  Index const patchSize, Index const windowSize, bool const doShift, PatchFunction const &apply, Cx5CMap const &x, Cx5Map &y)
+PatchScratch::PatchScratch(Index const patchSize, Sz5 const shape)
+  : szP{shape[0], patchSize, patchSize, patchSize, shape[4]}
+  , x{Cx5(szP)}
+  , y{Cx5(szP)}
+{
+}
+
+void Patches(Index const          patchSize,
+             Index const          windowSize,
+             bool const           doShift,
+             PatchFunction const &apply,
+             PatchScratch        &scratch,
+             Cx5CMap const       &x,
+             Cx5Map              &y)
 {
   Sz3 nWindows, shift;
 
@@ -30,6 +42,7 @@ void Patches(
   Log::Debug("Patch", "Windows {} Shifts {}", nWindows, shift);
   Sz5 const   szP{x.dimension(0), patchSize, patchSize, patchSize, x.dimension(4)};
   Index const inset = (patchSize - windowSize) / 2;
+  if (scratch.szP != szP) { throw Log::Failure("Patch", "Scratch patch size {} does not match {}", scratch.szP, szP); }
 
   for (Index iz = 0; iz < nWindows[2]; iz++) {
     for (Index iy = 0; iy < nWindows[1]; iy++) {
@@ -55,8 +68,10 @@ void Patches(
             stW2[ii + 1] = stW[ii + 1] - stP[ii + 1];
           }
           if (!empty) {
-            Cx5 xp = x.slice(stP, szP);
-            Cx5 yp = apply(xp);
+            auto &xp = scratch.x();
+            auto &yp = scratch.y();
+            xp = x.slice(stP, szP);
+            apply(xp, yp);
             y.slice(stW, szW) = yp.slice(stW2, szW);
           }
         }
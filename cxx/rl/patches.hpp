@@ -1,10 +1,32 @@
+#pragma once
+
+#include "sys/threads.hpp"
 #include "types.hpp"
 
 namespace rl {
 
-using PatchFunction = std::function<Cx5(Cx5 const &)>;
+/*
+ * Called with each patch and an output patch to fill. Both are per-thread buffers that persist across patches, so the
+ * output keeps its size from the previous call and only needs resizing if it changes.
+ */
+using PatchFunction = std::function<void(Cx5 const &xp, Cx5 &yp)>;
+
+/*
+ * Per-thread patch buffers, sized once by the caller (e.g. at operator construction) and reused by every call to Patches.
+ */
+struct PatchScratch
+{
+  PatchScratch(Index const patchSize, Sz5 const shape);
+  Sz5                   szP;
+  Threads::Scratch<Cx5> x, y;
+};
 
-void Patches(
-  Index const patchSize, Index const windowSize, bool const shift, PatchFunction const &apply, Cx5CMap const &x, Cx5Map &y);
+void Patches(Index const          patchSize,
+             Index const          windowSize,
+             bool const           shift,
+             PatchFunction const &apply,
+             PatchScratch        &scratch,
+             Cx5CMap const       &x,
+             Cx5Map              &y);
 
 } // namespace rl
@@ -111,15 +111,42 @@ auto KSpaceMulti(Cx5 const &smaps, GridOpts<3> const &gridOpts, Trajectory const
   return weights;
 }
 
+/*
+ * Iterative density compensation from Pipe & Menon, https://doi.org/10.1002/(SICI)1522-2594(199901)41:1<179::AID-MRM25>3.0.CO;2-V
+ * Repeatedly grids and degrids the weights with the gridding kernel, W <- W / (G G' W)
+ */
+auto KSpaceDCF(GridOpts<3> const &gridOpts, Trajectory const &traj, Index const its) -> Re2
+{
+  Log::Print("Precon", "Starting Pipe-Menon density compensation");
+  auto grid = TOps::Grid<3>::Make(gridOpts, traj, 1, nullptr);
+  Cx3  W(grid->oshape), GGW(grid->oshape);
+  Cx5  x(grid->ishape);
+  W.setConstant(Cx(1.f, 0.f));
+  for (Index ii = 0; ii < its; ii++) {
+    grid->adjoint(W, x);
+    grid->forward(x, GGW);
+    W.device(Threads::TensorDevice()) = (GGW.abs() > 0.f).select(W / GGW.abs().cast<Cx>(), GGW.constant(0.f));
+    Log::Print("Precon", "DCF iteration {} |G G' W| {}", ii, Norm<false>(GGW));
+  }
+  Re2 const weights = W.abs().chip<0>(0);
+  float const norm = Norm<true>(weights);
+  if (!std::isfinite(norm)) {
+    Log::Print("Precon", "DCF norm was not finite ({})", norm);
+  } else {
+    Log::Print("Precon", "DCF finished, norm {} min {} max {}", norm, Minimum(weights), Maximum(weights));
+  }
+  return weights;
+}
+
 auto LoadKSpacePrecon(std::string const &fname, Trajectory const &traj, Sz5 const shape) -> TOps::TOp<Cx, 5, 5>::Ptr
 {
   HD5::Reader reader(fname);
   Index const o = reader.order(HD5::Keys::Weights);
   if (o == 2) {
     Re2 const w = reader.readTensor<Re2>(HD5::Keys::Weights);
-    if (w.dimension(1) != traj.nSamples() || w.dimension(2) != traj.nTraces()) {
-      throw Log::Failure("Precon", "Preconditioner dimensions on disk {}x{} did not match trajectory {}x{}", w.dimension(1),
-                         w.dimension(2), traj.nSamples(), traj.nTraces());
+    if (w.dimension(0) != traj.nSamples() || w.dimension(1) != traj.nTraces()) {
+      throw Log::Failure("Precon", "Preconditioner dimensions on disk {}x{} did not match trajectory {}x{}", w.dimension(0),
+                         w.dimension(1), traj.nSamples(), traj.nTraces());
     }
     return std::make_shared<TOps::TensorScale<Cx, 5, 1, 2>>(shape, w.cast<Cx>());
   } else if (o == 3) {
@@ -148,6 +175,9 @@ auto MakeKSpacePrecon(
   } else if (opts.type == "single") {
     Re2 const w = KSpaceSingle(gridOpts, traj, opts.λ);
     return std::make_shared<TOps::TensorScale<Cx, 5, 1, 2>>(shape, w.cast<Cx>());
+  } else if (opts.type == "dcf") {
+    Re2 const w = KSpaceDCF(gridOpts, traj);
+    return std::make_shared<TOps::TensorScale<Cx, 5, 1, 2>>(shape, w.cast<Cx>());
   } else if (opts.type == "multi") {
     throw Log::Failure("Precon", "Multichannel preconditioner requested without SENSE maps");
   } else {
@@ -166,7 +196,12 @@ auto MakeKSpacePrecon(
   } else if (opts.type == "single") {
     Re2 const w = KSpaceSingle(gridOpts, traj, opts.λ);
     return std::make_shared<TOps::TensorScale<Cx, 5, 1, 2>>(shape, w.cast<Cx>());
+  } else if (opts.type == "dcf") {
+    Re2 const w = KSpaceDCF(gridOpts, traj);
+    return std::make_shared<TOps::TensorScale<Cx, 5, 1, 2>>(shape, w.cast<Cx>());
   } else if (opts.type == "multi") {
+    // The maps cover all slabs stacked along z, but the PSF is built from the single-slab trajectory
+    if (nS > 1) { throw Log::Failure("Precon", "Multichannel preconditioner does not support {} slabs", nS); }
     Re3 const w = KSpaceMulti(smaps, gridOpts, traj, opts.λ);
     return std::make_shared<TOps::TensorScale<Cx, 5, 0, 2>>(shape, w.cast<Cx>());
   } else {
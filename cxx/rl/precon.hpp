@@ -17,6 +17,8 @@ auto KSpaceSingle(GridOpts<3> const &gridOpts, Trajectory const &traj, float con
 
 auto KSpaceMulti(Cx5 const &smaps, GridOpts<3> const &gridOpts, Trajectory const &traj, float const λ) -> Re3;
 
+auto KSpaceDCF(GridOpts<3> const &gridOpts, Trajectory const &traj, Index const its = 10) -> Re2;
+
 auto MakeKSpacePrecon(
   PreconOpts const &opts, GridOpts<3> const &gridOpts, Trajectory const &traj, Index const nC, Index const nS, Index const nT)
   -> TOps::TOp<Cx, 5, 5>::Ptr;
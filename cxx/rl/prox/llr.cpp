@@ -7,6 +7,47 @@
 
 namespace rl::Proxs {
 
+SoftLLRScratch::SoftLLRScratch(Index const nB, Index const nVox)
+  : Ad(nB, nVox)
+  , G(nB, nB)
+  , PF(nB, nB)
+  , W(nB, nB)
+  , Wf(nB, nB)
+  , S(nB)
+  , f(nB)
+  , eig(nB)
+{
+}
+
+/*
+ * Soft-threshold the singular values of a patch, arranged as a basis × voxel matrix A = USV'. The basis dimension is tiny,
+ * so rather than an SVD of A this diagonalizes the Gram matrix AA' = US²U' and forms U f(S) U' A with
+ * f(S) = max(S - λ, 0) / S, which gives the same result without the voxel-sized singular vectors. The Gram matrix is
+ * formed in double precision, but it still squares the condition number, so if any singular values that survive the
+ * threshold are too small relative to the largest to be resolved this falls back to the SVD.
+ */
+void SoftLLR(float const λ, Cx5 const &xp, Cx5 &yp, SoftLLRScratch &s)
+{
+  auto const   A = CollapseToConstMatrix(xp);
+  double const t = λ;
+  s.Ad = A.cast<Cxd>();
+  s.G.noalias() = s.Ad * s.Ad.adjoint();
+  s.eig.compute(s.G);
+  s.S = s.eig.eigenvalues().array().max(0.).sqrt();
+  yp.resize(xp.dimensions());
+  if (((s.S > t) && (s.S < 1.e-4 * s.S.maxCoeff())).any()) {
+    auto const            svd = SVD<Cx>(A.transpose());
+    Eigen::VectorXf const sv = (svd.S.abs() > λ).select(svd.S * (svd.S.abs() - λ) / svd.S.abs(), 0.f);
+    CollapseToMatrix(yp).transpose() = svd.U * sv.asDiagonal() * svd.V.adjoint();
+  } else {
+    s.f = (s.S > t).select((s.S - t) / s.S, 0.);
+    s.PF.noalias() = s.eig.eigenvectors() * s.f.matrix().asDiagonal();
+    s.W.noalias() = s.PF * s.eig.eigenvectors().adjoint();
+    s.Wf = s.W.cast<Cx>();
+    CollapseToMatrix(yp).noalias() = s.Wf * A;
+  }
+}
+
 LLR::LLR(float const l, Index const p, Index const w, bool const doShift, Sz5 const s)
   : Prox<Cx>(Product(s))
   , λ{l}
@@ -14,6 +55,8 @@ LLR::LLR(float const l, Index const p, Index const w, bool const doShift, Sz5 co
   , windowSize{w}
   , shape{s}
   , shift{doShift}
+  , scratch{p, s}
+  , svt{SoftLLRScratch(s[0], p * p * p * s[4])}
 {
   /* λ needs to be scaled to work across block-sizes etc.
    * This is the scaling in BART which is taken from Ong 2016 Beyond Low Rank + Sparse: Multiscale Low Rank Matrix Decomposition
@@ -31,16 +74,8 @@ void LLR::apply(float const α, CMap const xin, Map zin) const
   Cx5Map      z(zin.data(), shape);
   float const realλ = λ * α;
 
-  auto softLLR = [realλ](Cx5 const &xp) {
-    Eigen::MatrixXcf patch = CollapseToMatrix(xp);
-    auto const       svd = SVD<Cx>(patch.transpose());
-    // Soft-threhold svals
-    Eigen::VectorXf const s = (svd.S.abs() > realλ).select(svd.S * (svd.S.abs() - realλ) / svd.S.abs(), 0.f);
-    patch = (svd.U * s.asDiagonal() * svd.V.adjoint()).transpose();
-    Cx5 yp = AsTensorMap(patch, xp.dimensions());
-    return yp;
-  };
-  Patches(patchSize, windowSize, shift, softLLR, x, z);
+  auto softLLR = [realλ, this](Cx5 const &xp, Cx5 &yp) { SoftLLR(realλ, xp, yp, svt()); };
+  Patches(patchSize, windowSize, shift, softLLR, scratch, x, z);
   Log::Debug("Prox", "LLR α {} λ {} t {} |x| {} |z| {}", α, λ, realλ, Norm<true>(x), Norm<true>(z));
 }
 
@@ -51,16 +86,8 @@ void LLR::apply(std::shared_ptr<Op> const α, CMap const xin, Map zin) const
     Cx5Map      z(zin.data(), shape);
     float const realλ = λ * realα->scale * std::sqrt(patchSize * patchSize * patchSize);
 
-    auto softLLR = [realλ](Cx5 const &xp) {
-      Eigen::MatrixXcf patch = CollapseToMatrix(xp);
-      auto const       svd = SVD<Cx>(patch.transpose());
-      // Soft-threhold svals
-      Eigen::VectorXf const s = (svd.S.abs() > realλ).select(svd.S * (svd.S.abs() - realλ) / svd.S.abs(), 0.f);
-      patch = (svd.U * s.asDiagonal() * svd.V.adjoint()).transpose();
-      Cx5 yp = AsTensorMap(patch, xp.dimensions());
-      return yp;
-    };
-    Patches(patchSize, windowSize, shift, softLLR, x, z);
+    auto softLLR = [realλ, this](Cx5 const &xp, Cx5 &yp) { SoftLLR(realλ, xp, yp, svt()); };
+    Patches(patchSize, windowSize, shift, softLLR, scratch, x, z);
     Log::Debug("Prox", "LLR α {} λ {} t {} |x| {} |z| {}", realα->scale, λ, realλ, Norm<true>(x), Norm<true>(z));
   } else {
     throw Log::Failure("Prox", "C++ is stupid");
@@ -1,9 +1,27 @@
 #pragma once
 
+#include "../patches.hpp"
 #include "prox.hpp"
 
+#include <Eigen/Eigenvalues>
+
 namespace rl::Proxs {
 
+/*
+ * Workspace for soft-thresholding the singular values of one basis × voxel patch, sized once per thread so that patches
+ * do not allocate. Only the rare SVD fallback allocates.
+ */
+struct SoftLLRScratch
+{
+  SoftLLRScratch(Index const nB, Index const nVox);
+  Eigen::MatrixXcd                                Ad, G, PF, W;
+  Eigen::MatrixXcf                                Wf;
+  Eigen::ArrayXd                                  S, f;
+  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXcd> eig;
+};
+
+void SoftLLR(float const λ, Cx5 const &xp, Cx5 &yp, SoftLLRScratch &scratch);
+
 /*
  * Locally Low-Rank Regularizer
  *
@@ -21,6 +39,10 @@ struct LLR final : Prox<Cx>
 
   void apply(float const α, CMap const x, Map z) const;
   void apply(std::shared_ptr<Op> const α, CMap const x, Map z) const;
+
+private:
+  mutable PatchScratch                     scratch;
+  mutable Threads::Scratch<SoftLLRScratch> svt;
 };
 
 } // namespace rl::Proxs
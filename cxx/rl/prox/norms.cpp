@@ -17,14 +17,12 @@ L1::L1(float const λ_, Index const sz_)
 void L1::apply(float const α, CMap const x, Map z) const
 {
   float t = α * λ;
-  Threads::ChunkFor(
-    [t, &x, &z](Index lo, Index hi) {
-      for (Index ii = lo; ii < hi; ii++) {
-        float const ax = std::abs(x[ii]);
-        z[ii] = ax < t ? 0.f : (1.f - t / ax) * x[ii];
-      }
-    },
-    x.size());
+  Threads::ParallelMap(x.size(), [t, &x, &z](Index lo, Index hi) {
+    for (Index ii = lo; ii < hi; ii++) {
+      float const ax = std::abs(x[ii]);
+      z[ii] = ax < t ? 0.f : (1.f - t / ax) * x[ii];
+    }
+  });
   if (Log::IsDebugging()) {
     Log::Print("Prox", "Soft Threshold α {} λ {} t {} |x| {} |z| {}", α, λ, t, ParallelNorm(x), ParallelNorm(z));
   }
@@ -0,0 +1,66 @@
+#include "scratch.hpp"
+
+#include "../log.hpp"
+
+#include <cstdlib>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace rl {
+
+namespace {
+size_t budget = 0;
+
+/* madvise/msync need page-aligned addresses */
+auto Align(void *base, size_t const offset, size_t const bytes) -> std::pair<char *, size_t>
+{
+  static size_t const page = sysconf(_SC_PAGESIZE);
+  size_t const        lo = (offset / page) * page;
+  return {static_cast<char *>(base) + lo, bytes + (offset - lo)};
+}
+} // namespace
+
+void SetMemoryBudget(size_t const bytes) { budget = bytes; }
+auto MemoryBudget() -> size_t { return budget; }
+auto OverBudget(size_t const bytes) -> bool { return budget > 0 && bytes > budget; }
+
+ScratchFile::ScratchFile(size_t const bytes)
+  : sz_{bytes}
+{
+  char const *dir = std::getenv("TMPDIR");
+  std::string tmpl = std::string(dir ? dir : "/tmp") + "/riesling-scratch-XXXXXX";
+  int const   fd = mkstemp(tmpl.data());
+  if (fd < 0) { throw Log::Failure("Scratch", "Could not create scratch file {}", tmpl); }
+  unlink(tmpl.c_str());
+  if (ftruncate(fd, sz_) != 0) {
+    close(fd);
+    throw Log::Failure("Scratch", "Could not resize scratch file to {} bytes", sz_);
+  }
+  ptr_ = mmap(nullptr, sz_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (ptr_ == MAP_FAILED) { throw Log::Failure("Scratch", "Could not map scratch file of {} bytes", sz_); }
+  Log::Print("Scratch", "Mapped {} GB scratch file in {}", sz_ / 1e9, dir ? dir : "/tmp");
+}
+
+ScratchFile::~ScratchFile() { munmap(ptr_, sz_); }
+
+auto ScratchFile::data() const -> void * { return ptr_; }
+auto ScratchFile::size() const -> size_t { return sz_; }
+
+void ScratchFile::prefetch(size_t const offset, size_t const bytes) const
+{
+  auto const [p, n] = Align(ptr_, offset, bytes);
+  madvise(p, n, MADV_WILLNEED);
+}
+
+void ScratchFile::writeback(size_t const offset, size_t const bytes) const
+{
+  auto const [p, n] = Align(ptr_, offset, bytes);
+  msync(p, n, MS_ASYNC);
+}
+
+} // namespace rl
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+
+namespace rl {
+
+/*
+ * Memory budget for large working buffers, in bytes. Zero (the default) means unlimited. Operators whose workspace
+ * would exceed the budget place it in a ScratchFile instead.
+ */
+void SetMemoryBudget(size_t const bytes);
+auto MemoryBudget() -> size_t;
+auto OverBudget(size_t const bytes) -> bool;
+
+/*
+ * File-backed scratch memory. The file is created in $TMPDIR (default /tmp), unlinked immediately and mapped shared, so
+ * the kernel pages it to and from disk rather than the allocation failing. The hint functions let callers stream through
+ * it - prefetch the next block while computing on the current one, and start writeback of blocks that are finished.
+ */
+struct ScratchFile
+{
+  ScratchFile(size_t const bytes);
+  ~ScratchFile();
+  ScratchFile(ScratchFile const &) = delete;
+  ScratchFile &operator=(ScratchFile const &) = delete;
+
+  auto data() const -> void *;
+  auto size() const -> size_t;
+  void prefetch(size_t const offset, size_t const bytes) const;
+  void writeback(size_t const offset, size_t const bytes) const;
+
+private:
+  void  *ptr_;
+  size_t sz_;
+};
+
+} // namespace rl
@@ -18,10 +18,104 @@
 #include <unsupported/Eigen/CXX11/Tensor>
 #include <unsupported/Eigen/CXX11/ThreadPool>
 
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <latch>
+#include <mutex>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 namespace {
 std::unique_ptr<Eigen::ThreadPool>           gp = nullptr;
 std::unique_ptr<Eigen::CoreThreadPoolDevice> coreDev = nullptr;
 std::unique_ptr<Eigen::ThreadPoolDevice>     tensorDev = nullptr;
+bool                                         numa = false;
+
+/*
+ * Bind each pool thread to one of the CPUs this process is allowed to run on. Every task blocks until all have started, which
+ * guarantees that each thread runs exactly one of them.
+ */
+void BindThreads(Eigen::ThreadPool *pool)
+{
+#ifdef __linux__
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+    rl::Log::Print("Thread", "Could not read CPU affinity, threads will not be bound");
+    return;
+  }
+  std::vector<int> cpus;
+  for (int ic = 0; ic < CPU_SETSIZE; ic++) {
+    if (CPU_ISSET(ic, &allowed)) { cpus.push_back(ic); }
+  }
+  Index const    nT = pool->NumThreads();
+  std::latch     started(nT);
+  Eigen::Barrier finished(nT);
+  for (Index it = 0; it < nT; it++) {
+    pool->Schedule([&] {
+      started.arrive_and_wait();
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      CPU_SET(cpus[pool->CurrentThreadId() % cpus.size()], &set);
+      pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+      finished.Notify();
+    });
+  }
+  finished.Wait();
+  rl::Log::Print("Thread", "Bound {} threads to {} CPUs", nT, cpus.size());
+#endif
+}
+
+/*
+ * Shared state of one ParallelFor. It is reference counted because helper tasks may start after the loop has finished,
+ * in which case they find no chunks left and return without touching the body, which lives on the caller's stack.
+ */
+struct Loop
+{
+  Loop(Index const n_, Index const g_, std::function<void(Index, Index)> const *b_)
+    : n{n_}
+    , grain{g_}
+    , body{b_}
+  {
+  }
+
+  Index                                   n, grain;
+  std::function<void(Index, Index)> const *body;
+  std::atomic<Index>                      next{0}, done{0};
+  std::mutex                              errorMutex;
+  std::exception_ptr                      error;
+};
+
+void Work(Loop &loop)
+{
+  for (;;) {
+    Index const lo = loop.next.fetch_add(loop.grain);
+    if (lo >= loop.n) { return; }
+    Index const hi = std::min(lo + loop.grain, loop.n);
+    try {
+      (*loop.body)(lo, hi);
+    } catch (...) {
+      std::scoped_lock lock(loop.errorMutex);
+      if (!loop.error) { loop.error = std::current_exception(); }
+    }
+    if (loop.done.fetch_add(hi - lo) + (hi - lo) == loop.n) { loop.done.notify_all(); }
+  }
+}
+
+#ifdef __linux__
+// All bits set, the kernel restricts this to the nodes that have memory and are allowed for this process
+unsigned long constexpr allNodes = ~0UL;
+unsigned long constexpr maxNode = sizeof(allNodes) * 8;
+#endif
 } // namespace
 
 namespace rl {
@@ -33,12 +127,19 @@ auto GlobalPool() -> Eigen::ThreadPool *
     auto const nt = std::thread::hardware_concurrency();
     Log::Debug("Thread", "Creating default thread pool with {} threads", nt);
     gp = std::make_unique<Eigen::ThreadPool>(nt);
+    if (numa) { BindThreads(gp.get()); }
   }
   return gp.get();
 }
 
 auto GlobalThreadCount() -> Index { return GlobalPool()->NumThreads(); }
 
+auto ThreadIndex() -> Index
+{
+  auto const id = GlobalPool()->CurrentThreadId();
+  return id < 0 ? GlobalPool()->NumThreads() : id;
+}
+
 void SetGlobalThreadCount(Index nt)
 {
   if (nt < 1) { nt = std::thread::hardware_concurrency(); }
@@ -46,6 +147,111 @@ void SetGlobalThreadCount(Index nt)
   gp = std::make_unique<Eigen::ThreadPool>(nt);
   coreDev = std::make_unique<Eigen::CoreThreadPoolDevice>(*gp, nt);
   tensorDev = std::make_unique<Eigen::ThreadPoolDevice>(gp.get(), nt);
+  if (numa) { BindThreads(gp.get()); }
+}
+
+void ParallelFor(Index const n, Index const grain, std::function<void(Index, Index)> const &body)
+{
+  if (n <= 0) { return; }
+  Index const nT = GlobalThreadCount();
+  Index const g = grain > 0 ? grain : (n + nT - 1) / nT;
+  Index const nChunks = (n + g - 1) / g;
+  if (nChunks == 1) {
+    body(0, n);
+    return;
+  }
+  auto loop = std::make_shared<Loop>(n, g, &body);
+  for (Index ih = 1; ih < std::min(nChunks, nT); ih++) {
+    gp->Schedule([loop] { Work(*loop); });
+  }
+  Work(*loop);
+  for (Index d = loop->done.load(); d < n; d = loop->done.load()) {
+    loop->done.wait(d);
+  }
+  if (loop->error) { std::rethrow_exception(loop->error); }
+}
+
+void CallerFirst(Index const n, std::function<void(Index)> const &f)
+{
+  if (n <= 0) { return; }
+  Index const                             nT = GlobalThreadCount();
+  std::function<void(Index, Index)> const rest = [&f](Index const lo, Index const hi) {
+    for (Index ii = lo; ii < hi; ii++) {
+      f(ii + 1);
+    }
+  };
+  auto loop = std::make_shared<Loop>(n - 1, 1, &rest);
+  for (Index ih = 0; ih < std::min(n - 1, nT); ih++) {
+    gp->Schedule([loop] { Work(*loop); });
+  }
+  std::exception_ptr error;
+  try {
+    f(0);
+  } catch (...) {
+    error = std::current_exception();
+  }
+  Work(*loop);
+  for (Index d = loop->done.load(); d < n - 1; d = loop->done.load()) {
+    loop->done.wait(d);
+  }
+  if (error) { std::rethrow_exception(error); }
+  if (loop->error) { std::rethrow_exception(loop->error); }
+}
+
+auto MapGrain(Index const n, float const nsPerElement) -> Index
+{
+  Index constexpr serial = 1 << 14;  // Below this many elements, never split a loop that has not been measured
+  float constexpr chunkNs = 50000.f; // Target time per chunk
+  Index constexpr minGrain = 1 << 10;
+  if (nsPerElement <= 0.f) {
+    return n < serial ? n : std::max(minGrain, n / (4 * GlobalThreadCount()));
+  }
+  if (n * nsPerElement < 2.f * chunkNs) { return n; }
+  Index const balanced = n / (4 * GlobalThreadCount()); // Enough chunks to balance if the cost varies
+  return std::max(minGrain, std::min(Index(chunkNs / nsPerElement), std::max(balanced, minGrain)));
+}
+
+void SetNUMA(bool const enable)
+{
+  numa = enable;
+  if (numa && gp) { BindThreads(gp.get()); } // Otherwise the pool binds its threads when created
+}
+
+auto NUMA() -> bool { return numa; }
+
+void Interleave(void *data, size_t const bytes)
+{
+#ifdef __linux__
+  if (!numa) { return; }
+  auto const page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  auto const start = (reinterpret_cast<uintptr_t>(data) + page - 1) & ~(page - 1);
+  auto const end = (reinterpret_cast<uintptr_t>(data) + bytes) & ~(page - 1);
+  if (end <= start) { return; }
+  if (syscall(SYS_mbind, start, end - start, MPOL_INTERLEAVE, &allNodes, maxNode, MPOL_MF_MOVE) != 0) {
+    Log::Debug("Thread", "Could not interleave {} bytes: {}", bytes, std::strerror(errno));
+  }
+#endif
+}
+
+InterleaveScope::InterleaveScope()
+  : active{false}
+{
+#ifdef __linux__
+  if (numa) {
+    if (syscall(SYS_set_mempolicy, MPOL_INTERLEAVE, &allNodes, maxNode) == 0) {
+      active = true;
+    } else {
+      Log::Debug("Thread", "Could not set interleave policy: {}", std::strerror(errno));
+    }
+  }
+#endif
+}
+
+InterleaveScope::~InterleaveScope()
+{
+#ifdef __linux__
+  if (active) { syscall(SYS_set_mempolicy, MPOL_DEFAULT, nullptr, 0); }
+#endif
 }
 
 auto CoreDevice() -> Eigen::CoreThreadPoolDevice &
@@ -1,8 +1,12 @@
 #pragma once
 
 #include "../types.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <span>
+#include <vector>
 
 // Forward declare
 namespace Eigen {
@@ -19,67 +23,120 @@ auto TensorDevice() -> Eigen::ThreadPoolDevice &;
 
 auto GlobalThreadCount() -> Index;
 void SetGlobalThreadCount(Index n_threads);
+auto ThreadIndex() -> Index; // Index of this thread in the global pool, GlobalThreadCount() for threads outside it
 
-template <typename F> void ChunkFor(F const &f, Index const sz)
+/*
+ * NUMA support. When enabled, the global pool threads are bound to cores, and shared read-mostly data can be interleaved
+ * across nodes so that no single socket serves all of it. Both are no-ops when disabled or on platforms other than Linux.
+ */
+void SetNUMA(bool const enable);
+auto NUMA() -> bool;
+void Interleave(void *data, size_t const bytes); // Migrate/interleave the pages of an existing allocation
+
+struct InterleaveScope // While in scope, pages first touched by this thread are interleaved
+{
+  InterleaveScope();
+  ~InterleaveScope();
+
+private:
+  bool active;
+};
+
+/*
+ * Parallel loop over [0, n) in chunks of grain elements (0 picks one chunk per thread). Chunks are claimed dynamically
+ * by the calling thread and by helper tasks in the global pool, so the caller works instead of blocking. This makes
+ * nested loops safe: a loop started from inside a pool task never waits on idle workers, and the helpers it spawns only
+ * run when a worker is free, so the pool is never oversubscribed. The first exception thrown by body is rethrown here
+ * once every claimed chunk has finished.
+ */
+void ParallelFor(Index const n, Index const grain, std::function<void(Index, Index)> const &body);
+
+/*
+ * Run f(0) ... f(n - 1) as concurrent tasks with f(0) on the calling thread. The others are claimed by helper tasks in the
+ * global pool, and by the caller once f(0) is done. FFTs nested inside a pool task run on a single thread (see
+ * FFT::ThreadPool), so putting the most expensive task first keeps the whole pool available to it.
+ */
+void CallerFirst(Index const n, std::function<void(Index)> const &f);
+
+/*
+ * Grain size for an elementwise loop of n elements, given the measured cost per element in nanoseconds (0 if not yet
+ * measured). Returns n when the loop is too cheap to be worth splitting.
+ */
+auto MapGrain(Index const n, float const nsPerElement) -> Index;
+
+/*
+ * Parallel loop for cheap elementwise kernels, f(lo, hi). Each call site (each distinct F) keeps a running estimate of
+ * its cost per element, measured from the chunks it runs, and sizes chunks from that so that they are long enough to
+ * amortise scheduling but short enough to balance. Small or cheap loops run serially on the calling thread.
+ */
+template <typename F> void ParallelMap(Index const n, F const &f)
 {
-  Index const nT = GlobalThreadCount();
-  if (sz == 0) {
-    return;
+  static std::atomic<float> cost = 0.f;
+  Index const               grain = MapGrain(n, cost.load(std::memory_order_relaxed));
+  std::atomic<int64_t>      ns = 0;
+  auto const                timed = [&](Index const lo, Index const hi) {
+    auto const start = std::chrono::steady_clock::now();
+    f(lo, hi);
+    ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+  };
+  if (grain >= n) {
+    timed(0, n);
   } else {
-    Index const    den = sz / nT;
-    Index const    rem = sz % nT;
-    Index const    nC = std::min<Index>(sz, nT);
-    Eigen::Barrier barrier(nC);
-    for (Index it = 0; it < nC; it++) {
-      Index const lo = it * den + std::min(it, rem);
-      Index const hi = (it + 1) * den + std::min(it + 1, rem);
-      GlobalPool()->Schedule([&barrier, f, lo, hi] {
-        f(lo, hi);
-        barrier.Notify();
-      });
-    }
-    barrier.Wait();
+    ParallelFor(n, grain, timed);
+  }
+  if (n > 0) {
+    float const c = cost.load(std::memory_order_relaxed);
+    float const measured = float(ns.load()) / n;
+    cost.store(c > 0.f ? 0.75f * c + 0.25f * measured : measured, std::memory_order_relaxed);
   }
 }
 
+template <typename F> void ChunkFor(F const &f, Index const sz, Index const grain = 0)
+{
+  ParallelFor(sz, grain, std::cref(f));
+}
+
 template <typename F, typename T, typename... Types> void ChunkFor(F const &f, std::vector<T> const &v, Types const &...args)
 {
-  Index const nT = GlobalThreadCount();
-  if (v.size() == 0) {
-    return;
-  } else {
-    Index const    nC = std::min<Index>(v.size(), nT);
-    Index const    den = v.size() / nC;
-    Index const    rem = v.size() % nC;
-    Eigen::Barrier barrier(nC);
-    for (Index it = 0; it < nC; it++) {
-      Index const lo = it * den + std::min(it, rem);
-      Index const hi = (it + 1) * den + std::min(it + 1, rem);
-      GlobalPool()->Schedule([&, f, lo, hi] {
-        f(lo, hi, v, args...);
-        barrier.Notify();
-      });
-    }
-    barrier.Wait();
-  }
+  ParallelFor(v.size(), 0, [&](Index const lo, Index const hi) { f(lo, hi, v, args...); });
 }
 
 template <typename F> void StridedFor(Index const sz, F const &f)
 {
-  Index const nT = GlobalThreadCount();
-  if (sz == 0) {
-    return;
-  } else {
-    Index const    st = std::min<Index>(sz, nT);
-    Eigen::Barrier barrier(st);
-    for (Index it = 0; it < st; it++) {
-      GlobalPool()->Schedule([&, f, it, st] {
-        f(it, st);
-        barrier.Notify();
-      });
+  Index const st = std::min<Index>(sz, GlobalThreadCount());
+  ParallelFor(st, 1, [&](Index const lo, Index const hi) {
+    for (Index it = lo; it < hi; it++) {
+      f(it, st);
     }
-    barrier.Wait();
+  });
+}
+
+/*
+ * One persistent buffer per pool thread, copied from a prototype once up front, so that hot loops reuse memory instead of
+ * hitting the allocator for every item. Threads outside the pool share the last buffer. The thread count must be set
+ * before construction.
+ */
+template <typename T> struct Scratch
+{
+  Scratch() = default;
+  Scratch(T const &prototype)
+    : buffers(GlobalThreadCount() + 1, prototype)
+  {
   }
+
+  auto operator()() -> T & { return buffers.at(ThreadIndex()); }
+
+private:
+  std::vector<T> buffers;
+};
+
+/*
+ * Zero memory in parallel so that pages are first touched, and hence placed, on the nodes of the threads that will later
+ * process them, instead of all landing on the node of the calling thread.
+ */
+template <typename T> void FirstTouch(T *data, Index const n)
+{
+  ChunkFor([data](Index const lo, Index const hi) { std::fill(data + lo, data + hi, T(0)); }, n);
 }
 
 } // namespace Threads
@@ -1,5 +1,13 @@
+#include "rl/algo/admm.hpp"
+#include "rl/algo/common.hpp"
+#include "rl/algo/eig.hpp"
+#include "rl/algo/fista.hpp"
 #include "rl/algo/lsmr.hpp"
+#include "rl/algo/pdhg.hpp"
+#include "rl/algo/reduce.hpp"
 #include "rl/op/ops.hpp"
+#include "rl/prox/norms.hpp"
+#include "rl/sys/threads.hpp"
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
@@ -7,6 +15,48 @@
 using namespace rl;
 using namespace Catch;
 
+namespace {
+// Counts applications of an operator, so that solvers can be compared by cost rather than by iterations
+struct Counted final : Ops::Op<Cx>
+{
+  using Ops::Op<Cx>::forward;
+  using Ops::Op<Cx>::adjoint;
+
+  Counted(Ptr a)
+    : Ops::Op<Cx>("Counted")
+    , A{a}
+  {
+  }
+
+  auto rows() const -> Index { return A->rows(); }
+  auto cols() const -> Index { return A->cols(); }
+
+  void forward(CMap const x, Map y) const
+  {
+    n++;
+    A->forward(x, y);
+  }
+  void adjoint(CMap const y, Map x) const
+  {
+    n++;
+    A->adjoint(y, x);
+  }
+  void iforward(CMap const x, Map y) const
+  {
+    n++;
+    A->iforward(x, y);
+  }
+  void iadjoint(CMap const y, Map x) const
+  {
+    n++;
+    A->iadjoint(y, x);
+  }
+
+  Ptr           A;
+  mutable Index n = 0;
+};
+} // namespace
+
 TEST_CASE("Algorithms", "[alg]")
 {
   Index const N = 8;
@@ -23,4 +73,257 @@ TEST_CASE("Algorithms", "[alg]")
     INFO("x " << x.transpose() << "\ny " << y.transpose() << "\nxx " << xx.transpose());
     CHECK((x - xx).stableNorm() == Approx(0.f).margin(1.e-3f));
   }
-}
\ No newline at end of file
+
+  SECTION("LSMR bfloat16")
+  {
+    LSMR lsmr{A, M};
+    auto const x32 = lsmr.run(y);
+    lsmr.opts.bf16 = true;
+    auto const x16 = lsmr.run(y);
+    INFO("x " << x.transpose() << "\nx32 " << x32.transpose() << "\nx16 " << x16.transpose());
+    CHECK((x - x16).stableNorm() == Approx(0.f).margin(1.e-2f));
+    CHECK((x32 - x16).stableNorm() == Approx(0.f).margin(1.e-2f));
+  }
+
+  SECTION("FISTA & POGM")
+  {
+    auto const        P = std::make_shared<Proxs::L1>(1.e-6f, N);
+    FISTA::Opts const opts{.imax = 256, .ε = 1.e-7f, .L = 81.f}; // |A'A| = (N + 1)²
+    FISTA const       fista{A, nullptr, P, opts};
+    POGM const        pogm{A, nullptr, P, opts};
+    auto const        xf = fista.run(y);
+    auto const        xp = pogm.run(y);
+    INFO("x " << x.transpose() << "\nxf " << xf.transpose() << "\nxp " << xp.transpose());
+    CHECK((x - xf).stableNorm() == Approx(0.f).margin(1.e-2f));
+    CHECK((x - xp).stableNorm() == Approx(0.f).margin(1.e-2f));
+  }
+
+  SECTION("PDHG")
+  {
+    auto const               P = std::make_shared<Proxs::L1>(1.e-6f, N);
+    std::vector<Regularizer> regs{Regularizer{nullptr, P, Sz4{N, 1, 1, 1}}};
+    bool const               balance = GENERATE(false, true);
+    PDHG::Opts const         opts{.imax = 1024, .ε = 0.f, .balance = balance};
+    PDHG const               pdhg(A, nullptr, regs, opts);
+    auto const               xp = pdhg.run(y);
+    INFO("balance " << balance << "\nx " << x.transpose() << "\nxp " << xp.transpose());
+    CHECK((x - xp).stableNorm() == Approx(0.f).margin(1.e-2f));
+
+    // The same problem with every row repeated at zero pre-conditioner weight, which must not produce NaN residuals
+    Eigen::VectorXcf w = Eigen::VectorXcf::Ones(2 * N);
+    Eigen::VectorXcf yy(2 * N);
+    w.tail(N).setZero();
+    yy << y, y;
+    auto const AA = std::make_shared<Ops::VStack<Cx>>(A, A);
+    auto const W = std::make_shared<Ops::MatMul<Cx>>(Eigen::MatrixXcf(w.asDiagonal()));
+    PDHG const pdhgW(AA, W, regs, opts);
+    auto const xw = pdhgW.run(yy);
+    INFO("xw " << xw.transpose());
+    CHECK(xw.allFinite());
+    CHECK((x - xw).stableNorm() == Approx(0.f).margin(1.e-2f));
+  }
+
+  SECTION("Operator applications")
+  {
+    // Count A and A' to reach the same accuracy on the same L1 problem. Recorded the first time each solver gets there.
+    auto const  P = std::make_shared<Proxs::L1>(1.e-6f, N);
+    auto const  C = std::make_shared<Counted>(A);
+    float const tol = 1.e-3f * x.stableNorm();
+    auto const  record = [&](Index &count) {
+      return [pc = &count, C, &x, tol](Index const, Eigen::VectorXcf const &xi) {
+        if (*pc < 0 && (xi - x).stableNorm() < tol) { *pc = C->n; }
+      };
+    };
+
+    FISTA::Opts const fopts{.imax = 256, .ε = 0.f, .L = 81.f};
+    Index             nF = -1, nP = -1, nA = -1;
+    FISTA             fista{C, nullptr, P, fopts};
+    fista.debug = record(nF);
+    fista.run(y);
+    C->n = 0;
+    POGM pogm{C, nullptr, P, fopts};
+    pogm.debug = record(nP);
+    pogm.run(y);
+    C->n = 0;
+    ADMM admm{C, nullptr, {Regularizer{nullptr, P, Sz4{N, 1, 1, 1}}},
+              ADMM::Opts{.outerLimit = 256, .ε = 0.f, .ρ = 1.f, .balance = false, .μ = 1.2f, .τmax = 10.f}};
+    admm.debug_x = record(nA);
+    admm.run(y);
+
+    // The proximal gradient methods need one A and one A' per iteration, ADMM adds an LSMR restart each outer iteration
+    INFO("A/A' applications FISTA " << nF << " POGM " << nP << " ADMM " << nA);
+    REQUIRE(nF > 0);
+    REQUIRE(nP > 0);
+    REQUIRE(nA > 0);
+    CHECK(nF <= nA);
+    CHECK(nP <= nA);
+  }
+
+  SECTION("ADMM inexact")
+  {
+    // Diagonal with condition number 10, where a single warm-started LSMR iteration is a poor x update
+    Index const           n = 32;
+    float const           λ = 1.e-2f;
+    Eigen::VectorXf const a =
+      Eigen::VectorXf::LinSpaced(n, 0.f, -1.f).unaryExpr([](float const e) { return std::pow(10.f, e); });
+    Eigen::VectorXcf xt = Eigen::VectorXcf::Zero(n);
+    for (Index ii = 0; ii < n; ii += 4) {
+      xt[ii] = Cx(1.f + ii, 0.5f);
+    }
+    // The problem is separable so the minimizer is a soft-threshold of A'y, scaled back by A'A
+    Eigen::VectorXcf xs(n);
+    for (Index ii = 0; ii < n; ii++) {
+      float const a2 = a[ii] * a[ii];
+      Cx const    g = a2 * xt[ii];
+      xs[ii] = std::abs(g) < λ ? Cx(0.f) : (1.f - λ / std::abs(g)) * g / a2;
+    }
+    auto const D = std::make_shared<Ops::MatMul<Cx>>(Eigen::MatrixXf(a.asDiagonal()));
+    auto const C = std::make_shared<Counted>(D);
+    auto const yd = D->forward(xt);
+
+    // Count A and A' until each run first reaches the same distance from the minimizer
+    float const tol = 1.e-3f * xs.stableNorm();
+    auto const  count = [&](bool const inexact) {
+      Index nApp = -1;
+      C->n = 0;
+      ADMM::Opts const opts{
+        .outerLimit = 512, .ε = 0.f, .ρ = 0.1f, .balance = false, .μ = 1.2f, .τmax = 10.f, .inexact = inexact};
+      ADMM admm{C, nullptr, {Regularizer{nullptr, std::make_shared<Proxs::L1>(λ, n), Sz4{n, 1, 1, 1}}}, opts};
+      admm.debug_x = [&](Index const, Eigen::VectorXcf const &xi) {
+        if (nApp < 0 && (xi - xs).stableNorm() < tol) { nApp = C->n; }
+      };
+      admm.run(yd);
+      return nApp;
+    };
+    Index const nE = count(false);
+    Index const nI = count(true);
+    INFO("A/A' applications default " << nE << " inexact " << nI);
+    REQUIRE(nE > 0);
+    REQUIRE(nI > 0);
+    CHECK(nI < nE);
+  }
+
+  SECTION("ADMM fast residuals")
+  {
+    // TV via a difference operator, where F'F != I so measuring the dual residual in the range of F differs
+    Eigen::MatrixXf D = Eigen::MatrixXf::Identity(N, N);
+    D.diagonal(1).setConstant(-1.f);
+    auto const               T = std::make_shared<Ops::MatMul<Cx>>(D);
+    std::vector<Regularizer> regs{Regularizer{T, std::make_shared<Proxs::L1>(1.e-1f, N), Sz4{N, 1, 1, 1}}};
+    // Without balancing the iterates do not depend on how the residuals are measured, only the reported values do
+    ADMM::Opts opts{.outerLimit = 256, .ε = 1.e-3f, .ρ = 1.f, .balance = false, .μ = 1.2f, .τmax = 10.f};
+    auto const run = [&](bool const exact, std::vector<float> &res) {
+      opts.exactResiduals = exact;
+      ADMM admm{A, nullptr, regs, opts};
+      admm.checkpoint = [&](Index const, float const, float const r, auto const &, auto const &, auto const &) {
+        res.push_back(r);
+      };
+      return admm.run(y);
+    };
+    std::vector<float> exactRes, fastRes;
+    auto const         xe = run(true, exactRes);
+    auto const         xf = run(false, fastRes);
+
+    // The stopping iteration is the number of checkpoints written
+    Index const nE = exactRes.size(), nF = fastRes.size();
+    float       lo = 1.f, hi = 1.f;
+    for (Index ii = 1; ii < std::min(nE, nF); ii++) {
+      lo = std::min(lo, fastRes[ii] / exactRes[ii]);
+      hi = std::max(hi, fastRes[ii] / exactRes[ii]);
+    }
+    INFO("Stopped exact " << nE << " fast " << nF << " fast/exact residual " << lo << " to " << hi);
+    REQUIRE(nE < opts.outerLimit);
+    CHECK(lo > 1.f / 3.f);
+    CHECK(hi < 3.f);
+    CHECK(std::abs(nF - nE) <= nE / 5);
+    CHECK((xe - xf).stableNorm() == Approx(0.f).margin(1.e-2f * xe.stableNorm()));
+  }
+
+  SECTION("ADMM resume")
+  {
+    Eigen::MatrixXf D = Eigen::MatrixXf::Identity(N, N);
+    D.diagonal(1).setConstant(-1.f);
+    auto const               T = std::make_shared<Ops::MatMul<Cx>>(D);
+    std::vector<Regularizer> regs{Regularizer{nullptr, std::make_shared<Proxs::L1>(1.e-2f, N), Sz4{N, 1, 1, 1}},
+                                  Regularizer{T, std::make_shared<Proxs::L1>(1.e-1f, N), Sz4{N, 1, 1, 1}}};
+    bool const               inexact = GENERATE(false, true);
+    ADMM::Opts const         opts{
+      .outerLimit = 16, .ε = 0.f, .ρ = 1.f, .balance = true, .μ = 1.2f, .τmax = 10.f, .inexact = inexact};
+    ADMM admm{A, nullptr, regs, opts};
+
+    // Capture the state after outer iteration k of an uninterrupted run, then restart from it
+    Index const                k = 5;
+    std::optional<ADMM::State> saved;
+    admm.checkpoint = [&](Index const io, float const ρ, float const res, auto const &xi, auto const &z, auto const &u) {
+      if (io == k) { saved = ADMM::State{io, ρ, res, xi, z, u}; }
+    };
+    auto const xa = admm.run(y);
+    REQUIRE(saved);
+    admm.checkpoint = nullptr;
+    admm.resume = saved;
+    auto const xb = admm.run(y);
+
+    INFO("inexact " << inexact << "\nxa " << xa.transpose() << "\nxb " << xb.transpose());
+    CHECK((xa.array() == xb.array()).all());
+  }
+
+  SECTION("ADMM concurrent regularizers")
+  {
+    // Two regularizers with distinct transforms and proxes, so ForEachReg runs them concurrently when allowed
+    Index const nThreads = Threads::GlobalThreadCount();
+    Threads::SetGlobalThreadCount(6);
+    Eigen::MatrixXf D = Eigen::MatrixXf::Identity(N, N);
+    D.diagonal(1).setConstant(-1.f);
+    auto const              T = std::make_shared<Ops::MatMul<Cx>>(D);
+    std::vector<Regularizer> regs{Regularizer{nullptr, std::make_shared<Proxs::L1>(1.e-2f, N), Sz4{N, 1, 1, 1}},
+                                  Regularizer{T, std::make_shared<Proxs::L1>(1.e-1f, N), Sz4{N, 1, 1, 1}}};
+    ADMM admm{A, nullptr, regs, ADMM::Opts{.outerLimit = 16, .ε = 0.f, .ρ = 1.f, .balance = true, .μ = 1.2f, .τmax = 10.f}};
+
+    std::vector<float> serialRes, concurrentRes;
+    admm.checkpoint = [&](Index const, float const, float const res, auto const &, auto const &, auto const &) {
+      serialRes.push_back(res);
+    };
+    Ops::SetConcurrentStacks(false);
+    auto const xs = admm.run(y);
+    admm.checkpoint = [&](Index const, float const, float const res, auto const &, auto const &, auto const &) {
+      concurrentRes.push_back(res);
+    };
+    Ops::SetConcurrentStacks(true);
+    auto const xc = admm.run(y);
+    Ops::SetConcurrentStacks(false);
+    Threads::SetGlobalThreadCount(nThreads);
+
+    INFO("xs " << xs.transpose() << "\nxc " << xc.transpose());
+    CHECK((xs - xc).stableNorm() == Approx(0.f).margin(1.e-6f * xs.stableNorm()));
+    REQUIRE(serialRes.size() == concurrentRes.size());
+    for (size_t ii = 0; ii < serialRes.size(); ii++) {
+      CHECK(concurrentRes[ii] == Approx(serialRes[ii]).epsilon(1.e-5f));
+    }
+  }
+
+  SECTION("Lanczos")
+  {
+    auto const l = Lanczos(A, nullptr, 32, 1.e-4f);
+    auto const p = PowerMethod(A, 32);
+    INFO("Lanczos " << l.val << " ± " << l.err << " its " << l.its << " Power " << p.val);
+    CHECK(l.val == Approx((N + 1.f) * (N + 1.f)).epsilon(1.e-3f));
+    CHECK(l.val + l.err >= (N + 1.f) * (N + 1.f) * (1.f - 1.e-4f));
+    CHECK(l.its < 32);
+  }
+}
+
+TEST_CASE("Compensated reductions", "[alg]")
+{
+  Index const            n = GENERATE(1, 7, 33, 1001, 100003); // Exercise the SIMD remainders
+  Eigen::VectorXcf const a = Eigen::VectorXcf::Random(n);
+  Eigen::VectorXcf const b = Eigen::VectorXcf::Random(n);
+  Eigen::VectorXcd const ad = a.cast<std::complex<double>>();
+  Eigen::VectorXcd const bd = b.cast<std::complex<double>>();
+  auto const             dot = CompensatedDot(a.data(), b.data(), n);
+  double const           norm2 = CompensatedNorm2(a.data(), n);
+  INFO(CompensatedISA() << " n " << n << " dot " << dot << " ref " << ad.dot(bd) << " |a|² " << norm2);
+  CHECK(std::abs(dot - ad.dot(bd)) == Approx(0.).margin(1.e-12 * n));
+  CHECK(norm2 == Approx(ad.squaredNorm()).epsilon(1.e-12));
+  CHECK(std::abs(ParallelDot(a, b) - Cx(ad.dot(bd))) == Approx(0.f).margin(1.e-5f * n));
+  CHECK(ParallelNorm(a) == Approx(std::sqrt(ad.squaredNorm())).epsilon(1.e-6));
+}
@@ -1,5 +1,6 @@
 #include "rl/algo/decomp.hpp"
 #include "rl/algo/stats.hpp"
+#include "rl/prox/llr.hpp"
 #include "rl/tensors.hpp"
 
 #include <catch2/catch_test_macros.hpp>
@@ -21,4 +22,42 @@ TEST_CASE("decomp")
     auto cov = Covariance(data);
     Eig<Cx> eig(cov);
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("SoftLLR")
+{
+  // A patch of a 4-element basis over 3³ voxels, built from chosen singular values so the threshold is known
+  Index const      nB = 4, nV = 27;
+  Eigen::MatrixXcf U = Eigen::MatrixXcf::Random(nB, nB).householderQr().householderQ();
+  Eigen::MatrixXcf V = Eigen::MatrixXcf::Random(nV, nV).householderQr().householderQ();
+  V = V.leftCols(nB).eval();
+
+  Proxs::SoftLLRScratch scratch(nB, nV);
+  auto const            check = [&](Eigen::ArrayXf const &sv, float const λ) {
+    Cx5 xp(nB, 3, 3, 3, 1), yp(nB, 3, 3, 3, 1);
+    CollapseToMatrix(xp) = U * sv.matrix().cast<Cx>().asDiagonal() * V.adjoint();
+    Proxs::SoftLLR(λ, xp, yp, scratch);
+
+    // Reference is the soft-thresholded SVD of the patch
+    SVD<Cx> const          svd(CollapseToConstMatrix(xp));
+    Eigen::VectorXf const  s = (svd.S > λ).select(svd.S - λ, 0.f);
+    Eigen::MatrixXcf const ref = svd.U * s.cast<Cx>().asDiagonal() * svd.V.adjoint();
+    INFO("S " << sv.transpose() << " λ " << λ);
+    CHECK((CollapseToMatrix(yp) - ref).norm() == Approx(0.f).margin(1.e-5f * ref.norm()));
+  };
+
+  SECTION("Gram")
+  {
+    Eigen::ArrayXf sv(nB);
+    sv << 4.f, 2.f, 1.f, 0.5f;
+    check(sv, 1.5f);
+  }
+
+  SECTION("Fallback")
+  {
+    // A surviving singular value too small relative to the largest for the Gram matrix, which forces the SVD path
+    Eigen::ArrayXf sv(nB);
+    sv << 1.f, 0.5f, 4.e-5f, 0.f;
+    check(sv, 1.e-5f);
+  }
+}
@@ -54,3 +54,37 @@ TEST_CASE("FFT3", "[FFT]")
     CHECK(Norm<true>(data - ref) == Approx(0.f).margin(1.e-6f * N * nc));
   }
 }
+
+TEST_CASE("FFTBatch", "[FFT]")
+{
+  // The batched transforms must match the threaded ones element-wise, including the shifts
+  SECTION("<4, 3>")
+  {
+    Cx4 data(4, 6, 8, 5), ref(4, 6, 8, 5);
+    data.setRandom();
+    ref = data;
+    Cx4Map dm(data.data(), data.dimensions());
+    FFT::ForwardBatch(dm, Sz3{0, 1, 2}, 3);
+    FFT::Forward(ref, Sz3{0, 1, 2});
+    CHECK(Norm<false>(data - ref) == Approx(0.f).margin(1.e-5f * Norm<false>(ref)));
+    FFT::AdjointBatch(dm, Sz3{0, 1, 2}, 3);
+    FFT::Adjoint(ref, Sz3{0, 1, 2});
+    CHECK(Norm<false>(data - ref) == Approx(0.f).margin(1.e-5f * Norm<false>(ref)));
+  }
+
+  SECTION("<5, 3>")
+  {
+    Index const batchDim = GENERATE(0, 4);
+    Cx5         data(3, 8, 4, 6, 2), ref(3, 8, 4, 6, 2);
+    data.setRandom();
+    ref = data;
+    Cx5Map dm(data.data(), data.dimensions());
+    FFT::ForwardBatch(dm, Sz3{1, 2, 3}, batchDim);
+    FFT::Forward(ref, Sz3{1, 2, 3});
+    INFO("Batch dimension " << batchDim);
+    CHECK(Norm<false>(data - ref) == Approx(0.f).margin(1.e-5f * Norm<false>(ref)));
+    FFT::AdjointBatch(dm, Sz3{1, 2, 3}, batchDim);
+    FFT::Adjoint(ref, Sz3{1, 2, 3});
+    CHECK(Norm<false>(data - ref) == Approx(0.f).margin(1.e-5f * Norm<false>(ref)));
+  }
+}
@@ -0,0 +1,36 @@
+#include "rl/fft.hpp"
+#include "rl/multires.hpp"
+#include "rl/op/pad.hpp"
+#include "rl/tensors.hpp"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace rl;
+using namespace Catch;
+
+TEST_CASE("FourierUpsample", "[multires]")
+{
+  Sz5 const small{8, 8, 8, 2, 1}, large{16, 16, 16, 2, 1};
+
+  // A band-limited image, with k-space confined to the central half of the small matrix
+  Cx5 ks(small);
+  ks.setZero();
+  Sz5 const st{2, 2, 2, 0, 0}, sz{4, 4, 4, 2, 1};
+  Cx5       band(sz);
+  band.setRandom();
+  ks.slice(st, sz) = band;
+  Cx5 x = ks;
+  FFT::Adjoint(x, Sz3{0, 1, 2});
+
+  Cx5 const y = FourierUpsample(x, large);
+  REQUIRE(y.dimensions() == large);
+
+  // The low frequencies are unchanged and nothing is added outside them
+  Cx5 yks = y;
+  FFT::Forward(yks, Sz3{0, 1, 2});
+  TOps::Pad<Cx, 5> pad(small, large);
+  Cx5 const        central = pad.adjoint(yks);
+  CHECK(Norm<false>(central - ks) == Approx(0.f).margin(1.e-5f * Norm<false>(ks)));
+  CHECK(Norm<false>(yks) == Approx(Norm<false>(ks)).epsilon(1.e-5f));
+}
@@ -119,3 +119,40 @@ TEST_CASE("GridB", "[grid]")
   INFO("NC\n" << nc2);
   CHECK(Norm<false>(nc2 - noncart) == Approx(0.f).margin(1e-2f));
 }
+
+TEST_CASE("GridFrames", "[grid]")
+{
+  Threads::SetGlobalThreadCount(1);
+  Index const M = 6;
+  auto const  matrix = Sz1{M};
+  Re3         points(1, 3, 2);
+  points.setZero();
+  points(0, 0, 0) = -3.f;
+  points(0, 1, 0) = -2.f;
+  points(0, 2, 0) = -1.f;
+  points(0, 0, 1) = 0;
+  points(0, 1, 1) = 1.f;
+  points(0, 2, 1) = 2.f;
+  TrajectoryN<1> const traj(points, matrix);
+
+  Basis basis(2, 1, 2);
+  basis.B.setZero();
+  basis.B(0, 0, 0) = 1.f;
+  basis.B(1, 0, 1) = 1.f;
+  CHECK(basis.frames() == std::vector<int16_t>{0, 1});
+  using GType = TOps::Grid<1, rl::TopHat<1>>;
+  auto grid = GType::Make(GridOpts<1>{.osamp = 1.f}, traj, 1, &basis);
+  Cx3  noncart(grid->oshape);
+  noncart.setConstant(1.f);
+  Cx3 cart = grid->adjoint(noncart);
+  INFO("GRID\n" << cart);
+  for (Index ii = 0; ii < 3; ii++) {
+    CHECK(cart(ii, 0, 0).real() == Approx(1.f).margin(1e-2f));
+    CHECK(cart(ii, 0, 1).real() == Approx(0.f).margin(1e-2f));
+    CHECK(cart(ii + 3, 0, 0).real() == Approx(0.f).margin(1e-2f));
+    CHECK(cart(ii + 3, 0, 1).real() == Approx(1.f).margin(1e-2f));
+  }
+  Cx3 nc2 = grid->forward(cart);
+  INFO("NC\n" << nc2);
+  CHECK(Norm<false>(nc2 - noncart) == Approx(0.f).margin(1e-2f));
+}
@@ -1,7 +1,9 @@
 #include "rl/op/nufft.hpp"
+#include "rl/op/nufft-stack.hpp"
 #include "rl/basis/fourier.hpp"
 #include "rl/log.hpp"
 #include "rl/op/grid.hpp"
+#include "rl/sys/scratch.hpp"
 
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
@@ -67,3 +69,76 @@ TEST_CASE("NUFFTB", "[nufft]")
   ks = nufft.forward(img);
   CHECK(std::real(ks(0, 0, 0)) == Approx(1.f).margin(2.e-2f));
 }
+
+TEST_CASE("NUFFTStack", "[nufft]")
+{
+  Index const M = 8;
+  Sz3 const   matrix{M, M, M};
+  Index const nI = 2;
+  Re3         points(3, M, nI * M);
+  for (Index iz = 0; iz < M; iz++) {
+    for (Index ii = 0; ii < nI; ii++) {
+      for (Index is = 0; is < M; is++) {
+        points(0, is, iz * nI + ii) = ii == 0 ? -0.5f * M + is : 0.f;
+        points(1, is, iz * nI + ii) = ii == 1 ? -0.5f * M + is : 0.f;
+        points(2, is, iz * nI + ii) = -0.5f * M + iz;
+      }
+    }
+  }
+  Trajectory const traj(points, matrix);
+  GridOpts<3>      gridOpts{.osamp = 2.f};
+  auto const       layout = TOps::NUFFTStack::Detect(gridOpts, traj, nullptr);
+  REQUIRE(layout);
+  CHECK(layout->traj.nTraces() == nI);
+
+  auto stack = TOps::NUFFTStack::Make(gridOpts, traj, *layout, 2, nullptr);
+  auto full = TOps::NUFFT<3>::Make(gridOpts, traj, 2, nullptr);
+  REQUIRE(stack->ishape == full->ishape);
+  REQUIRE(stack->oshape == full->oshape);
+  Cx5 img(full->ishape);
+  img.setRandom();
+  Cx3 const ks1 = full->forward(img);
+  Cx3 const ks2 = stack->forward(img);
+  CHECK(Norm<false>(ks1 - ks2) / Norm<false>(ks1) == Approx(0).margin(2.e-2f));
+  Cx5 const img1 = full->adjoint(ks1);
+  Cx5 const img2 = stack->adjoint(ks1);
+  CHECK(Norm<false>(img1 - img2) / Norm<false>(img1) == Approx(0).margin(2.e-2f));
+
+  points(2, 1, 0) = 0.5f; // No longer Cartesian along z
+  CHECK(!TOps::NUFFTStack::Detect(gridOpts, Trajectory(points, matrix), nullptr));
+}
+
+TEST_CASE("NUFFTOutOfCore", "[nufft]")
+{
+  Index const M = 8, nC = 3;
+  Sz3 const   matrix{M, M, M};
+  Re3         points(3, M, M);
+  for (Index it = 0; it < M; it++) {
+    for (Index is = 0; is < M; is++) {
+      points(0, is, it) = -0.5f * M + is;
+      points(1, is, it) = -0.5f * M + it;
+      points(2, is, it) = 0.25f * (is - it);
+    }
+  }
+  Trajectory const traj(points, matrix);
+  GridOpts<3>      gridOpts{.osamp = 2.f};
+
+  auto const   inMemory = TOps::NUFFT<3>::Make(gridOpts, traj, nC, nullptr);
+  size_t const budget = MemoryBudget();
+  SetMemoryBudget(1); // Forces the file-backed workspace and the FFT one volume at a time
+  auto const outOfCore = TOps::NUFFT<3>::Make(gridOpts, traj, nC, nullptr);
+  SetMemoryBudget(budget);
+  REQUIRE(outOfCore->ishape == inMemory->ishape);
+  REQUIRE(outOfCore->oshape == inMemory->oshape);
+
+  Cx5 img(inMemory->ishape);
+  Cx3 ks(inMemory->oshape);
+  img.setRandom();
+  ks.setRandom();
+  Cx3 const ks1 = inMemory->forward(img);
+  Cx3 const ks2 = outOfCore->forward(img);
+  CHECK(Norm<false>(ks1 - ks2) == Approx(0).margin(1.e-5f * Norm<false>(ks1)));
+  Cx5 const img1 = inMemory->adjoint(ks);
+  Cx5 const img2 = outOfCore->adjoint(ks);
+  CHECK(Norm<false>(img1 - img2) == Approx(0).margin(1.e-5f * Norm<false>(img1)));
+}
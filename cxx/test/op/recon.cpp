@@ -3,7 +3,9 @@
 #include "rl/log.hpp"
 #include "rl/op/compose.hpp"
 #include "rl/op/nufft-lowmem.hpp"
+#include "rl/op/nufft-stack.hpp"
 #include "rl/op/nufft.hpp"
+#include "rl/op/recon.hpp"
 #include "rl/op/sense.hpp"
 
 #include <catch2/catch_approx.hpp>
@@ -82,3 +84,49 @@ TEST_CASE("ReconLowmem", "[recon]")
   // INFO("ks\n" << ks);
   CHECK(Norm<false>(ks) == Approx(Norm<false>(img)).margin(2.e-1f));
 }
+
+TEST_CASE("ReconMultislab", "[recon]")
+{
+  Index const M = 8, nC = 4, nSlab = 2;
+  auto const  matrix = Sz3{M, M, M};
+  Re3         points(3, 3, 1);
+  points.setZero();
+  points(0, 0, 0) = -0.4f * M;
+  points(1, 0, 0) = -0.4f * M;
+  points(0, 2, 0) = 0.4f * M;
+  points(1, 2, 0) = 0.4f * M;
+  Trajectory const  traj(points, matrix);
+  GridOpts<3> const gopts{.osamp = 1.3f};
+
+  // Maps and image cover the whole volume, with the slabs stacked along z
+  Cx5 maps(M, M, M * nSlab, nC, 1);
+  maps.setRandom();
+  auto const recon = SENSERecon(gopts, traj, nSlab, 1, nullptr, maps, false);
+  CHECK(recon->ishape == Sz5{M, M, M * nSlab, 1, 1});
+  CHECK(recon->oshape == Sz5{nC, traj.nSamples(), traj.nTraces(), nSlab, 1});
+
+  Cx5 img(recon->ishape), ks(recon->oshape);
+  img.setRandom();
+  ks.setRandom();
+  Cx5 const fwd = recon->forward(img);
+  Cx5 const adj = recon->adjoint(ks);
+
+  // Each slab should match a single-slab recon on its part of the volume
+  auto nufft = TOps::MakeNUFFT(gopts, traj, nC, nullptr);
+  for (Index is = 0; is < nSlab; is++) {
+    Sz5 const  st{0, 0, is * M, 0, 0};
+    Sz5 const  sz{M, M, M, nC, 1};
+    Cx5 const  slabMaps = maps.slice(st, sz);
+    auto const sense = std::make_shared<TOps::SENSE>(slabMaps, 1);
+    TOps::Compose<TOps::SENSE, TOps::TOp<Cx, 5, 3>> ref(sense, nufft);
+
+    Cx4 const slabImg = img.chip<4>(0).slice(Sz4{0, 0, is * M, 0}, Sz4{M, M, M, 1});
+    Cx3 const slabKs = ks.chip<4>(0).chip<3>(is);
+    Cx3 const refFwd = ref.forward(slabImg);
+    Cx4 const refAdj = ref.adjoint(slabKs);
+    Cx3 const outFwd = fwd.chip<4>(0).chip<3>(is);
+    Cx4 const outAdj = adj.chip<4>(0).slice(Sz4{0, 0, is * M, 0}, Sz4{M, M, M, 1});
+    CHECK(Norm<false>(outFwd - refFwd) == Approx(0.f).margin(1.e-5f * Norm<false>(refFwd)));
+    CHECK(Norm<false>(outAdj - refAdj) == Approx(0.f).margin(1.e-5f * Norm<false>(refAdj)));
+  }
+}
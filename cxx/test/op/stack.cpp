@@ -0,0 +1,71 @@
+#include "rl/op/ops.hpp"
+#include "rl/sys/threads.hpp"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace rl;
+using namespace Catch;
+
+TEST_CASE("Stacks", "[ops]")
+{
+  using Matrix = Ops::MatMul<Cx>::Matrix;
+  using Vector = Ops::Op<Cx>::Vector;
+  Index const nThreads = Threads::GlobalThreadCount();
+  Threads::SetGlobalThreadCount(6); // Two threads per block so the concurrent path is taken
+  Index const nB = 3;
+
+  SECTION("VStack")
+  {
+    std::vector<Ops::Op<Cx>::Ptr> ops;
+    for (Index ib = 0; ib < nB; ib++) {
+      ops.push_back(std::make_shared<Ops::MatMul<Cx>>(Matrix::Random(16 + 8 * ib, 24)));
+    }
+    Ops::Op<Cx>::Ptr stack = std::make_shared<Ops::VStack<Cx>>(ops);
+    Vector const     x = Vector::Random(stack->cols());
+    Vector const     y = Vector::Random(stack->rows());
+    Vector const     x0 = Vector::Random(stack->cols());
+
+    Ops::SetConcurrentStacks(false);
+    Vector const fs = stack->forward(x);
+    Vector const as = stack->adjoint(y);
+    Vector       ias = x0;
+    stack->iadjoint(y, ias);
+
+    Ops::SetConcurrentStacks(true);
+    Vector const fc = stack->forward(x);
+    Vector const ac = stack->adjoint(y);
+    Vector       iac = x0;
+    stack->iadjoint(y, iac);
+    Ops::SetConcurrentStacks(false);
+
+    CHECK((fc - fs).norm() == Approx(0.f).margin(1.e-6f * fs.norm()));
+    CHECK((ac - as).norm() == Approx(0.f).margin(1.e-6f * as.norm()));
+    CHECK((iac - ias).norm() == Approx(0.f).margin(1.e-6f * ias.norm()));
+  }
+
+  SECTION("DStack")
+  {
+    std::vector<Ops::Op<Cx>::Ptr> ops;
+    for (Index ib = 0; ib < nB; ib++) {
+      ops.push_back(std::make_shared<Ops::MatMul<Cx>>(Matrix::Random(16 + 8 * ib, 8 + 4 * ib)));
+    }
+    Ops::Op<Cx>::Ptr stack = std::make_shared<Ops::DStack<Cx>>(ops);
+    Vector const     x = Vector::Random(stack->cols());
+    Vector const     y = Vector::Random(stack->rows());
+
+    Ops::SetConcurrentStacks(false);
+    Vector const fs = stack->forward(x);
+    Vector const as = stack->adjoint(y);
+
+    Ops::SetConcurrentStacks(true);
+    Vector const fc = stack->forward(x);
+    Vector const ac = stack->adjoint(y);
+    Ops::SetConcurrentStacks(false);
+
+    CHECK((fc - fs).norm() == Approx(0.f).margin(1.e-6f * fs.norm()));
+    CHECK((ac - as).norm() == Approx(0.f).margin(1.e-6f * as.norm()));
+  }
+
+  Threads::SetGlobalThreadCount(nThreads);
+}
@@ -24,3 +24,20 @@ TEST_CASE("Preconditioner", "[precon]")
   CHECK(sc(1, 0) == Approx(1.f).margin(1.e-1f));
   CHECK(sc(2, 0) == Approx(1.f).margin(1.e-1f));
 }
+
+TEST_CASE("DCF", "[precon]")
+{
+  Index const M = 16;
+  Sz3 const   matrix{M, M, M};
+  Re3         points(3, 4, 1);
+  points.setZero();
+  points(0, 0, 0) = -0.25f * M;
+  points(0, 3, 0) = 0.25f * M;
+  Trajectory const traj(points, matrix);
+  auto const       w = KSpaceDCF(GridOpts<3>(), traj);
+  INFO("Weights\n" << w);
+  // The two samples at the centre overlap exactly and should share the weight of one isolated sample
+  CHECK(w(0, 0) == Approx(w(3, 0)).margin(1.e-3f));
+  CHECK(w(1, 0) == Approx(0.5f * w(0, 0)).margin(1.e-2f));
+  CHECK(w(2, 0) == Approx(0.5f * w(0, 0)).margin(1.e-2f));
+}
@@ -0,0 +1,54 @@
+#include "rl/log.hpp"
+#include "rl/sys/threads.hpp"
+#include <algorithm>
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace rl;
+
+TEST_CASE("Threads", "[threads]")
+{
+  Index const N = 1000;
+
+  SECTION("ChunkFor")
+  {
+    std::vector<int> hits(N, 0);
+    Threads::ChunkFor([&](Index const lo, Index const hi) {
+      for (Index ii = lo; ii < hi; ii++) {
+        hits[ii]++;
+      }
+    }, N, 7);
+    CHECK(std::all_of(hits.begin(), hits.end(), [](int const h) { return h == 1; }));
+  }
+
+  SECTION("Nested")
+  {
+    std::atomic<Index> sum = 0;
+    Threads::StridedFor(N, [&](Index const st, Index const sz) {
+      for (Index ii = st; ii < N; ii += sz) {
+        Threads::ChunkFor([&](Index const lo, Index const hi) { sum += hi - lo; }, N);
+      }
+    });
+    CHECK(sum == N * N);
+  }
+
+  SECTION("CallerFirst")
+  {
+    Index const      n = 8;
+    std::vector<int> hits(n, 0);
+    Index            first = -1;
+    Threads::CallerFirst(n, [&](Index const ii) {
+      if (ii == 0) { first = Threads::ThreadIndex(); }
+      hits[ii]++;
+    });
+    CHECK(first == Threads::ThreadIndex()); // The first task ran on this thread, outside the pool
+    CHECK(std::all_of(hits.begin(), hits.end(), [](int const h) { return h == 1; }));
+  }
+
+  SECTION("Exceptions")
+  {
+    CHECK_THROWS_AS(Threads::ChunkFor([](Index const lo, Index const) {
+      if (lo == 0) { throw Log::Failure("Test", "Failure"); }
+    }, N, 1), Log::Failure);
+  }
+}